@@ -47,9 +47,11 @@ limitations under the License.
 //#define INPUT_IMAGE "./samples/couple.bmp"   // Input file path
 
 
+#define FRAME_NUM (2U)                      // Number of frames in input buffer (2^n)
+
 __attribute__((section(".ARM.__at_0x60000000")))
 __attribute__((aligned(4)))
-static uint8_t ImageBuf[IMAGE_DATA_SIZE];   // Buffer for holding an input frame
+static uint8_t ImageBuf[FRAME_NUM * IMAGE_DATA_SIZE];   // Buffer for holding input frames
 
 #define HRES                    192
 #define VRES                    192
@@ -62,13 +64,25 @@ static uint8_t ImageBuf[IMAGE_DATA_SIZE];   // Buffer for holding an input frame
 #define TEST_CYCLE_COUNT_16 16
 
 
+static volatile uint32_t Overflows = 0U;  // Video input overflow events
+
+/*---------------------------------------------------------------------------
+ * Video driver events (called from the video interrupt)
+ *---------------------------------------------------------------------------*/
+static void VideoEvent(uint32_t channel, uint32_t event)
+{
+  if ((channel == VIDEO_DRV_IN0) && ((event & VIDEO_DRV_EVENT_OVERFLOW) != 0U)) {
+    Overflows++;
+  }
+}
+
 /*---------------------------------------------------------------------------
  * User application initialization
  *---------------------------------------------------------------------------*/
 void app_init()
 {
   /* Initializing video driver */
-  if (VideoDrv_Initialize(NULL) != VIDEO_DRV_OK) {
+  if (VideoDrv_Initialize(VideoEvent) != VIDEO_DRV_OK) {
     log_error("Failed to initialise video driver\n");
   }
 }
@@ -79,6 +93,8 @@ void app_init()
 void app_run()
 {
   void* imgFrame = NULL;
+  int32_t frame = -1;
+  uint32_t overflowCount = 0U;
 
 #ifdef LCD_OUT
   /* Video coordinates on LCD */
@@ -96,7 +112,7 @@ void app_run()
   }
 
    /* Set input video buffer */
-   if (VideoDrv_SetBuf(VIDEO_DRV_IN0,  ImageBuf, IMAGE_DATA_SIZE) != VIDEO_DRV_OK) {
+   if (VideoDrv_SetBuf(VIDEO_DRV_IN0,  ImageBuf, sizeof(ImageBuf)) != VIDEO_DRV_OK) {
      log_error("Failed to set buffer for video input");
      return;
    }
@@ -116,26 +132,21 @@ void app_run()
    /* Loop for obtaining video frames */
    while (1) {
 
-     VideoDrv_Status_t status;
-
-     /* Wait for video input frame */
-     do {
-       status = VideoDrv_GetStatus(VIDEO_DRV_IN0);
-       if (status.overflow != 0U) {
-         log_info("Overflow");
-       }
-     } while (status.buf_empty != 0U);
-
-     /* Stop video stream upon end of stream status */
-     if (status.eos != 0U) {
+     /* Wait for video input frame, stop video stream at end of stream */
+     if (VideoDrv_WaitFrame(VIDEO_DRV_IN0, osWaitForever) != VIDEO_DRV_OK) {
        VideoDrv_StreamStop(VIDEO_DRV_IN0);
        break;
      }
 
-     /* Get input video frame buffer */
-     imgFrame = VideoDrv_GetFrameBuf(VIDEO_DRV_IN0);
+     /* Overflow is reported by event, reading the status clears it */
+     if (overflowCount != Overflows) {
+       (void)VideoDrv_GetStatus(VIDEO_DRV_IN0);
+       overflowCount = Overflows;
+       log_info("Overflow");
+     }
 
-     if (imgFrame == NULL ) {
+     frame = VideoDrv_AcquireFrame(VIDEO_DRV_IN0, &imgFrame);
+     if (frame < 0) {
        log_error("Invalid frame.");
        break;
      }
@@ -143,7 +154,7 @@ void app_run()
 #ifdef LCD_OUT
      /* Display image on the LCD. */
      hal_lcd_display_image(
-       ImageBuf,
+       imgFrame,
        IMAGE_HEIGHT,
        IMAGE_WIDTH,
        CHANNELS_IMAGE_DISPLAYED,
@@ -152,15 +163,9 @@ void app_run()
        dataPsnImgDownscaleFactor);
 #endif
 
-      /* Release input frame */
-      VideoDrv_ReleaseFrame(VIDEO_DRV_IN0);
-
-     /* Exit the loop when reaching end of stream */
-     if (status.eos != 0U) {
-       VideoDrv_StreamStop(VIDEO_DRV_IN0);
-       break;
-     }
-
+     /* Release the frame once displayed (the LCD keeps a copy),
+        the driver captures the next frame into the other one during display */
+     VideoDrv_ReleaseFrameHandle(VIDEO_DRV_IN0, frame);
   }
 
   log_info("Video Stream stopped");
@@ -26,6 +26,8 @@
 
 #include <stdio.h>
 
+#include "micro_logger.h"
+
 extern int stdout_init(void);
 extern void app_main(void *argument);
 
@@ -49,6 +51,8 @@ int main(void)
    
   osKernelInitialize();        // Initialize CMSIS-RTOS2
 
+  log_init();                  // Initialize logger (drain thread in tokenized mode)
+
   app_main_tid = osThreadNew(app_main, NULL, NULL); // Create application thread
 
   osKernelStart();             // Start RTOS scheduler
@@ -0,0 +1,185 @@
+# Copyright (c) 2026 Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the License); you may
+# not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an AS IS BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Decoder for tokenized micro_logger output (MICRO_LOGGER_TOKENIZED)
+#
+# Reads the console output of the application, replaces every "@L" record
+# (format string address, header, tick count and raw arguments in hex) by the
+# text the non-tokenized logger would print, and passes all other lines
+# through. Format strings and constant string arguments are taken from the ELF.
+
+try:
+    import argparse
+    import re
+    import struct
+    import sys
+except ImportError as err:
+    print(f"Log decoder ImportError: {err}")
+    raise
+
+
+LEVEL_PREFIX = ("ERROR: ", "WARNING: ", "INFO: ", "DEBUG: ")
+
+SHF_ALLOC    = 0x2
+SHT_NOBITS   = 8
+
+# printf conversion specification (flags, width, precision, length, conversion)
+FORMAT_SPEC  = re.compile(r'%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diouxXcsp%])')
+
+
+## Loaded sections of an ELF file (little-endian, 32 or 64-bit)
+class ElfImage:
+    def __init__(self, name):
+        with open(name, 'rb') as f:
+            self.data = f.read()
+        if self.data[0:4] != b'\x7fELF' or self.data[5] != 1:
+            raise ValueError(f"Not a little-endian ELF file: {name}")
+
+        if self.data[4] == 1:
+            shoff,                    = struct.unpack_from('<I', self.data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self.data, 0x2E)
+            sh_format = '<IIIIIIIIII'
+        else:
+            shoff,                    = struct.unpack_from('<Q', self.data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self.data, 0x3A)
+            sh_format = '<IIQQQQIIQQ'
+
+        headers = [struct.unpack_from(sh_format, self.data, shoff + (i * shentsize)) for i in range(shnum)]
+        strtab  = headers[shstrndx]
+
+        # (name, address, contents) of all allocated sections with contents
+        self.sections = []
+        for sh_name, sh_type, sh_flags, sh_addr, sh_offset, sh_size, *_ in headers:
+            if (sh_flags & SHF_ALLOC) == 0 or sh_type == SHT_NOBITS:
+                continue
+            end  = self.data.index(b'\0', strtab[4] + sh_name)
+            name = self.data[(strtab[4] + sh_name):end].decode()
+            self.sections.append((name, sh_addr, self.data[sh_offset:(sh_offset + sh_size)]))
+
+    ## Read NUL-terminated string at target address
+    #  @return string, None when the address is not in a loaded section
+    def string(self, address):
+        for _, addr, contents in self.sections:
+            if addr <= address < (addr + len(contents)):
+                offset = address - addr
+                end = contents.find(b'\0', offset)
+                if end < 0:
+                    end = len(contents)
+                return contents[offset:end].decode(errors='replace')
+        return None
+
+
+## Format arguments according to a printf format string
+#  @param elf ELF image (for %s arguments)
+#  @param fmt format string
+#  @param args list of 32-bit argument words
+def formatArgs(elf, fmt, args):
+    args = list(args)
+
+    def convert(match):
+        flags, width, precision, _, conv = match.groups()
+        if conv == '%':
+            return '%'
+        value = args.pop(0) if args else 0
+        spec  = '%' + flags + width + (('.' + precision) if precision else '')
+        if conv in 'di':
+            value = value - (1 << 32) if value & 0x80000000 else value
+            return (spec + 'd') % value
+        if conv in 'ouxX':
+            return (spec + ('d' if conv == 'u' else conv)) % value
+        if conv == 'c':
+            return (spec + 'c') % chr(value & 0xFF)
+        if conv == 'p':
+            return (spec + 's') % f"0x{value:08x}"
+        text = elf.string(value)
+        return (spec + 's') % (text if text is not None else f"<0x{value:08x}>")
+
+    return FORMAT_SPEC.sub(convert, fmt)
+
+
+## Decode one log record
+#  @param elf ELF image
+#  @param words record words (format address, header, tick count, payload)
+#  @param timestamps prefix lines with the kernel tick count
+#  @return list of text lines
+def decodeRecord(elf, words, timestamps=False):
+    address, header, tick = words[0:3]
+    payload   = words[3:]
+    level     = (header >> 24) & 0xFF
+    elem_size = (header >> 16) & 0xFF
+
+    fmt = elf.string(address)
+    if fmt is None:
+        return [f"<unknown log token 0x{address:08x}>"]
+
+    if elem_size == 0:
+        text = formatArgs(elf, fmt, payload)
+    else:
+        # Array record: element count followed by the packed elements
+        count = payload[0] if payload else 0
+        data  = struct.pack(f'<{len(payload) - 1}I', *payload[1:])
+        code  = { 1: 'B', 2: 'H', 4: 'I' }[elem_size]
+        elems = struct.unpack_from(f'<{count}{code}', data)
+        text  = fmt.replace('%s', "".join(f"{x} " for x in elems), 1)
+
+    prefix = LEVEL_PREFIX[level] if level < len(LEVEL_PREFIX) else ""
+    if timestamps:
+        prefix = f"[{tick:>10}] " + prefix
+    return [prefix + line for line in text.split('\n') if line != ""]
+
+
+## Decode log stream
+#  @param elf ELF image
+#  @param src input text stream
+#  @param dst output text stream
+def decodeStream(elf, src, dst, timestamps=False):
+    words = None
+
+    def flush():
+        if words is not None:
+            for line in decodeRecord(elf, words, timestamps):
+                dst.write(line + '\n')
+
+    for line in src:
+        line = line.rstrip('\r\n')
+        if line.startswith('@+') and words is not None:
+            words.extend(int(x, 16) for x in line[2:].split())
+            continue
+        flush()
+        words = None
+        if line.startswith('@L'):
+            words = [int(x, 16) for x in line[2:].split()]
+        else:
+            dst.write(line + '\n')
+    flush()
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(description="Decode tokenized micro_logger output")
+    parser.add_argument("elf", help="Application image (ELF/AXF) the log was produced by")
+    parser.add_argument("log", nargs='?', help="Captured console output (default: stdin)")
+    parser.add_argument("--timestamps", action="store_true", help="Prefix lines with kernel tick count")
+    return parser.parse_args()
+
+
+if __name__ == '__main__':
+    args = parse_arguments()
+    elf  = ElfImage(args.elf)
+    if args.log is None:
+        decodeStream(elf, sys.stdin, sys.stdout, args.timestamps)
+    else:
+        with open(args.log, 'r', errors='replace') as f:
+            decodeStream(elf, f, sys.stdout, args.timestamps)
@@ -21,14 +21,15 @@
 
 #include "video_drv.h"
 #include "arm_vsi.h"
-
-#include "platform_irq.h"
+#include "vsi_stream.h"
+#include "video_regs.h"
 
 #ifdef _RTE_
 #include "RTE_Components.h"
 #endif
 
 #include CMSIS_device_header
+#include "cmsis_os2.h"
 
 // Video channel definitions
 #ifndef VIDEO_INPUT_CHANNELS
@@ -44,80 +45,76 @@
 #error "Maximum 2 Video Output channels are supported!"
 #endif
 
-// Video peripheral definitions
-#define VideoI0                 ARM_VSI4_NS                // Video Input channel 0 access struct
-#define VideoI0_IRQn            ARM_VSI4_IRQn           // Video Input channel 0 Interrupt number
-#define VideoI0_Handler         ARM_VSI4_Handler        // Video Input channel 0 Interrupt handler
-#define VideoI1                 ARM_VSI5_NS                // Video Input channel 1 access struct
-#define VideoI1_IRQn            ARM_VSI5_IRQn           // Video Input channel 1 Interrupt number
-#define VideoI1_Handler         ARM_VSI5_Handler        // Video Input channel 1 Interrupt handler
-#define VideoO0                 ARM_VSI6_NS                // Video Output channel 0 access struct
-#define VideoO0_IRQn            ARM_VSI6_IRQn           // Video Output channel 0 Interrupt number
-#define VideoO0_Handler         ARM_VSI6_Handler        // Video Output channel 0 Interrupt handler
-#define VideoO1                 ARM_VSI7_NS                // Video Output channel 1 access struct
-#define VideoO1_IRQn            ARM_VSI7_IRQn           // Video Output channel 1 Interrupt number
-#define VideoO1_Handler         ARM_VSI7_Handler        // Video Output channel 1 Interrupt handler
-
-// Video Peripheral registers
-#define Reg_MODE                Regs[0]  // Mode: 0=Input, 1=Output
-#define Reg_CONTROL             Regs[1]  // Control: enable, continuos, flush
-#define Reg_STATUS              Regs[2]  // Status: active, buf_empty, buf_full, overflow, underflow, eos
-#define Reg_FILENAME_LEN        Regs[3]  // Filename length
-#define Reg_FILENAME_CHAR       Regs[4]  // Filename character
-#define Reg_FILENAME_VALID      Regs[5]  // Filename valid flag
-#define Reg_FRAME_WIDTH         Regs[6]  // Requested frame width
-#define Reg_FRAME_HEIGHT        Regs[7]  // Requested frame height
-#define Reg_COLOR_FORMAT        Regs[8]  // Color format
-#define Reg_FRAME_RATE          Regs[9]  // Frame rate
-#define Reg_FRAME_INDEX         Regs[10] // Frame index
-#define Reg_FRAME_COUNT         Regs[11] // Frame count
-#define Reg_FRAME_COUNT_MAX     Regs[12] // Frame count maximum
-
-// Video MODE register defintions
-#define Reg_MODE_IO_Pos                 0U
-#define Reg_MODE_IO_Msk                 (1UL << Reg_MODE_IO_Pos)
-#define Reg_MODE_Input                  (0UL << Reg_MODE_IO_Pos)
-#define Reg_MODE_Output                 (1UL << Reg_MODE_IO_Pos)
-
-// Video CONTROL register definitions
-#define Reg_CONTROL_ENABLE_Pos          0U
-#define Reg_CONTROL_ENABLE_Msk          (1UL << Reg_CONTROL_ENABLE_Pos)
-#define Reg_CONTROL_CONTINUOS_Pos       1U
-#define Reg_CONTROL_CONTINUOS_Msk       (1UL << Reg_CONTROL_CONTINUOS_Pos)
-#define Reg_CONTROL_BUF_FLUSH_Pos       2U
-#define Reg_CONTROL_BUF_FLUSH_Msk       (1UL << Reg_CONTROL_BUF_FLUSH_Pos)
-
-// Video STATUS register definitions
-#define Reg_STATUS_ACTIVE_Pos           0U
-#define Reg_STATUS_ACTIVE_Msk           (1UL << Reg_STATUS_ACTIVE_Pos)
-#define Reg_STATUS_BUF_EMPTY_Pos        1U
-#define Reg_STATUS_BUF_EMPTY_Msk        (1UL << Reg_STATUS_BUF_EMPTY_Pos)
-#define Reg_STATUS_BUF_FULL_Pos         2U
-#define Reg_STATUS_BUF_FULL_Msk         (1UL << Reg_STATUS_BUF_FULL_Pos)
-#define Reg_STATUS_OVERFLOW_Pos         3U
-#define Reg_STATUS_OVERFLOW_Msk         (1UL << Reg_STATUS_OVERFLOW_Pos)
-#define Reg_STATUS_UNDERFLOW_Pos        4U
-#define Reg_STATUS_UNDERFLOW_Msk        (1UL << Reg_STATUS_UNDERFLOW_Pos)
-#define Reg_STATUS_EOS_Pos              5U
-#define Reg_STATUS_EOS_Msk              (1UL << Reg_STATUS_EOS_Pos)
-
-// IRQ Status register definitions
-#define Reg_IRQ_Status_FRAME_Pos        0U
-#define Reg_IRQ_Status_FRAME_Msk        (1UL << Reg_IRQ_Status_FRAME_Pos)
-#define Reg_IRQ_Status_OVERFLOW_Pos     1U
-#define Reg_IRQ_Status_OVERFLOW_Msk     (1UL << Reg_IRQ_Status_OVERFLOW_Pos)
-#define Reg_IRQ_Status_UNDERFLOW_Pos    2U
-#define Reg_IRQ_Status_UNDERFLOW_Msk    (1UL << Reg_IRQ_Status_UNDERFLOW_Pos)
-#define Reg_IRQ_Status_EOS_Pos          3U
-#define Reg_IRQ_Status_EOS_Msk          (1UL << Reg_IRQ_Status_EOS_Pos)
-
-#define Reg_IRQ_Status_Msk              Reg_IRQ_Status_FRAME_Msk     | \
-                                        Reg_IRQ_Status_OVERFLOW_Msk  | \
-                                        Reg_IRQ_Status_UNDERFLOW_Msk | \
-                                        Reg_IRQ_Status_EOS_Msk
-
-// Video peripheral access structure
-static ARM_VSI_Type * const pVideo[4] = { VideoI0, VideoO0, VideoI1, VideoO1 };
+// Video channel to VSI instance mapping
+#ifndef VIDEO_DRV_IN0_VSI
+#define VIDEO_DRV_IN0_VSI       4U                      // Video Input channel 0 VSI instance
+#endif
+#ifndef VIDEO_DRV_IN1_VSI
+#define VIDEO_DRV_IN1_VSI       5U                      // Video Input channel 1 VSI instance
+#endif
+#ifndef VIDEO_DRV_OUT0_VSI
+#define VIDEO_DRV_OUT0_VSI      6U                      // Video Output channel 0 VSI instance
+#endif
+#ifndef VIDEO_DRV_OUT1_VSI
+#define VIDEO_DRV_OUT1_VSI      7U                      // Video Output channel 1 VSI instance
+#endif
+
+// Check if video channel is enabled
+#define VIDEO_CHANNEL_VALID(ch) ((((ch) & 1U) == 0U) ? (((ch) >> 1) < VIDEO_INPUT_CHANNELS) : \
+                                                       (((ch) >> 1) < VIDEO_OUTPUT_CHANNELS))
+
+// Check if video channel is an input channel (IN0, IN1)
+#define VIDEO_CHANNEL_INPUT(ch) (((ch) & 1U) == 0U)
+
+// Video channel VSI instances (IN0, OUT0, IN1, OUT1)
+static const uint8_t VideoVSI[4] = { VIDEO_DRV_IN0_VSI, VIDEO_DRV_OUT0_VSI, VIDEO_DRV_IN1_VSI, VIDEO_DRV_OUT1_VSI };
+
+// Video channel streams
+static VSI_Stream_t Video[4];
+
+// Video channel frame size in bytes
+static uint32_t FrameSize[4];
+
+// Video channel frame queue (one bit per buffer frame)
+// Frame count and index mirror FRAME_COUNT and FRAME_INDEX registers, updated from the
+// frame interrupt and on release, so that the registers are not read on every frame
+typedef struct {
+  uint32_t acquired;                                    // Frames held by the application
+  uint32_t released;                                    // Frames released, waiting for older frames
+  uint32_t count;                                       // Number of acquired frames not returned yet
+  uint32_t frames;                                      // Received frames (input) or free frames (output)
+  uint32_t index;                                       // Oldest frame index
+} Video_Queue_t;
+static Video_Queue_t Queue[4];
+
+// Video channel frame wait (event flag bit per channel)
+static osEventFlagsId_t  FrameEvent = NULL;
+static volatile uint32_t FrameWait  = 0U;               // Channels with a waiting thread
+static volatile uint32_t StreamEnd  = 0U;               // Channels with end of stream or stopped stream
+
+// Video channel event routing (frame and end of stream events)
+static osEventFlagsId_t  ChannelEvent[4];
+static uint32_t          ChannelFlags[4];
+
+// Video stream descriptor (filename and stream parameters in one DMA block)
+// Record: header word (tag << 16) | payload size in bytes, payload padded to 4 bytes
+#define VIDEO_DESC_END          0U                      // End of descriptor
+#define VIDEO_DESC_FILENAME     1U                      // Filename (characters)
+#define VIDEO_DESC_FRAME_WIDTH  2U                      // Frame width (32-bit)
+#define VIDEO_DESC_FRAME_HEIGHT 3U                      // Frame height (32-bit)
+#define VIDEO_DESC_COLOR_FORMAT 4U                      // Color format (32-bit)
+#define VIDEO_DESC_FRAME_RATE   5U                      // Frame rate (32-bit)
+#define VIDEO_DESC_FRAME_RATE_DEN 6U                    // Frame rate denominator (32-bit)
+
+#ifndef VIDEO_DESC_SIZE
+#define VIDEO_DESC_SIZE         256U                    // Descriptor buffer size in bytes
+#endif
+#ifndef VIDEO_DESC_TIMEOUT
+#define VIDEO_DESC_TIMEOUT      1000U                   // Descriptor transfer timeout in kernel ticks
+#endif
+
+// Descriptor processed event flag (bits above the frame wait flags)
+#define VIDEO_DESC_EVENT(ch)    (1UL << (4U + (ch)))
 
 // Driver State
 static uint8_t  Initialized = 0U;
@@ -126,15 +123,38 @@ static uint8_t  Configured[4] = { 0U, 0U, 0U, 0U };
 // Event Callback
 static VideoDrv_Event_t CB_Event = NULL;
 
-// Video Interrupt Handler
-static void Video_Handler (uint32_t channel) {
-  uint32_t irq_status;
-  uint32_t event;
+// Reset frame count and index (empty buffer)
+static void Video_QueueReset (uint32_t channel) {
+
+  memset(&Queue[channel], 0, sizeof(Video_Queue_t));
+  if (!VIDEO_CHANNEL_INPUT(channel)) {
+    Queue[channel].frames = Video[channel].block_num;
+  }
+}
+
+// Read frame count and index from the Video registers
+static void Video_QueueSync (uint32_t channel) {
+
+  if (VIDEO_CHANNEL_INPUT(channel)) {
+    Queue[channel].frames = Video[channel].vsi->Reg_FRAME_COUNT;
+  } else {
+    Queue[channel].frames = Video[channel].block_num - Video[channel].vsi->Reg_FRAME_COUNT;
+  }
+  Queue[channel].index = Video[channel].vsi->Reg_FRAME_INDEX;
+}
+
+// Return oldest frame to the Video peripheral (called with interrupts disabled)
+static void Video_QueueRelease (uint32_t channel) {
 
-  irq_status = pVideo[channel]->IRQ.Status;
-  pVideo[channel]->IRQ.Clear = irq_status;
-  __DSB();
-  __ISB();
+  Video[channel].vsi->Reg_FRAME_INDEX = 0U;
+  Queue[channel].frames--;
+  Queue[channel].index = (Queue[channel].index + 1U) & (Video[channel].block_num - 1U);
+}
+
+// Video Interrupt callback
+static void Video_Handler (VSI_Stream_t *stream, uint32_t irq_status) {
+  uint32_t channel = (uint32_t)(stream - Video);
+  uint32_t event;
 
   event = 0U;
   if (irq_status & Reg_IRQ_Status_FRAME_Msk) {
@@ -150,103 +170,194 @@ static void Video_Handler (uint32_t channel) {
     event |= VIDEO_DRV_EVENT_EOS;
   }
 
-  if (CB_Event != NULL) {
+  if ((irq_status & Reg_IRQ_Status_DESCRIPTOR_Msk) != 0U) {
+    osEventFlagsSet(FrameEvent, VIDEO_DESC_EVENT(channel));
+  }
+
+  if ((event & (VIDEO_DRV_EVENT_OVERFLOW | VIDEO_DRV_EVENT_UNDERFLOW | VIDEO_DRV_EVENT_EOS)) != 0U) {
+    // Frame dropped or stream ended, frame count may differ from transferred frames
+    Video_QueueSync(channel);
+  } else if ((event & VIDEO_DRV_EVENT_FRAME) != 0U) {
+    // Frame received (input) or frame sent and free again (output)
+    if (Queue[channel].frames < Video[channel].block_num) {
+      Queue[channel].frames++;
+    }
+  }
+
+  if ((event & VIDEO_DRV_EVENT_EOS) != 0U) {
+    StreamEnd |= 1U << channel;
+  }
+
+  if ((event & (VIDEO_DRV_EVENT_FRAME | VIDEO_DRV_EVENT_EOS)) != 0U) {
+    // Wake thread waiting in VideoDrv_WaitFrame
+    if ((FrameWait & (1U << channel)) != 0U) {
+      FrameWait &= ~(1U << channel);
+      osEventFlagsSet(FrameEvent, 1U << channel);
+    }
+    if (ChannelEvent[channel] != NULL) {
+      osEventFlagsSet(ChannelEvent[channel], ChannelFlags[channel]);
+    }
+  }
+
+  if ((CB_Event != NULL) && (event != 0U)) {
     CB_Event(channel, event);
   }
 }
 
-// Video channel 0 Interrupt Handler
-#if (VIDEO_INPUT_CHANNELS >= 1)
-void VideoI0_Handler (void);
-void VideoI0_Handler (void) {
-  Video_Handler(0U);
+// Number of frames available for VideoDrv_AcquireFrame
+static uint32_t Video_FramesAvailable (uint32_t channel) {
+  uint32_t frames;
+
+  // Received frames (input) or free frames (output)
+  frames = Queue[channel].frames;
+  if (frames <= Queue[channel].count) {
+    return 0U;
+  }
+
+  return (frames - Queue[channel].count);
 }
-#endif
 
-// Video channel 1 Interrupt Handler
-#if (VIDEO_OUTPUT_CHANNELS >= 1)
-void VideoO0_Handler (void);
-void VideoO0_Handler (void) {
-  Video_Handler(1U);
+// Frame size in bytes (0 for unsupported color format)
+static uint32_t Video_FrameSize (uint32_t frame_width, uint32_t frame_height, uint32_t color_format) {
+  uint32_t pixel_size;
+  uint32_t block_size;
+
+  switch (color_format) {
+    case VIDEO_DRV_COLOR_GRAYSCALE8:
+      pixel_size = 8U;
+      break;
+    case VIDEO_DRV_COLOR_YUV420:
+    case VIDEO_DRV_COLOR_NV12:
+    case VIDEO_DRV_COLOR_NV21:
+      pixel_size = 12U;
+      break;
+    case VIDEO_DRV_COLOR_BGR565:
+      pixel_size = 16U;
+      break;
+    case VIDEO_DRV_COLOR_RGB888:
+      pixel_size = 24U;
+      break;
+    default:
+      return 0U;
+  }
+
+  block_size = (((frame_width * frame_height) * pixel_size) + 7U) / 8U;
+  block_size = (block_size + 3U) & ~3U;
+
+  return block_size;
 }
-#endif
 
-// Video channel 2 Interrupt Handler
-#if (VIDEO_INPUT_CHANNELS >= 2)
-void VideoI1_Handler (void);
-void VideoI1_Handler (void) {
-  Video_Handler(2U);
+// Add record to stream descriptor, returns next word position (0 when descriptor is full)
+static uint32_t Video_DescAdd (uint32_t *desc, uint32_t pos, uint32_t tag, const void *data, uint32_t size) {
+  uint32_t words = (size + 3U) / 4U;
+
+  // Keep room for the end record
+  if ((pos + 1U + words + 1U) > (VIDEO_DESC_SIZE / 4U)) {
+    return 0U;
+  }
+
+  desc[pos] = (tag << 16) | size;
+  if (words != 0U) {
+    // Clear padding of the last payload word
+    desc[pos + words] = 0U;
+    memcpy(&desc[pos + 1U], data, size);
+  }
+
+  return (pos + 1U + words);
 }
-#endif
 
-// Video channel 3 Interrupt Handler
-#if (VIDEO_OUTPUT_CHANNELS >= 2)
-void VideoO1_Handler (void);
-void VideoO1_Handler (void) {
-  Video_Handler(3U);
+// Add 32-bit parameter record to stream descriptor
+static uint32_t Video_DescAddParam (uint32_t *desc, uint32_t pos, uint32_t tag, uint32_t value) {
+  return Video_DescAdd(desc, pos, tag, &value, 4U);
+}
+
+// Transfer stream descriptor to the peripheral (stream must be inactive)
+static int32_t Video_SendDescriptor (uint32_t channel, uint32_t *desc, uint32_t pos) {
+  VSI_Stream_t *stream = &Video[channel];
+  ARM_VSI_Type *vsi    = stream->vsi;
+  uint32_t      flags;
+
+  if (osKernelGetState() != osKernelRunning) {
+    return VIDEO_DRV_ERROR;
+  }
+
+  desc[pos++] = VIDEO_DESC_END << 16;
+
+  osEventFlagsClear(FrameEvent, VIDEO_DESC_EVENT(channel));
+
+  // Single M2P block with the descriptor, the next DMA block is taken as descriptor
+  vsi->Reg_DESCRIPTOR = pos * 4U;
+  vsi->DMA.Control    = 0U;
+  vsi->DMA.Address    = (uint32_t)desc;
+  vsi->DMA.BlockNum   = 1U;
+  vsi->DMA.BlockSize  = pos * 4U;
+  vsi->DMA.Control    = ARM_VSI_DMA_Direction_M2P | ARM_VSI_DMA_Enable_Msk;
+  vsi->Timer.Interval = 1U;
+  vsi->Timer.Control  = ARM_VSI_Timer_Trig_DMA_Msk |
+                        ARM_VSI_Timer_Trig_IRQ_Msk |
+                        ARM_VSI_Timer_Run_Msk;
+
+  flags = osEventFlagsWait(FrameEvent, VIDEO_DESC_EVENT(channel), osFlagsWaitAny, VIDEO_DESC_TIMEOUT);
+
+  // Restore stream Timer and DMA setup
+  vsi->Timer.Control  = 0U;
+  vsi->DMA.Control    = 0U;
+  vsi->Timer.Interval = stream->interval_cur;
+  if (stream->buf != NULL) {
+    VSI_Stream_SetBuf(stream, stream->buf, stream->block_num, stream->block_size);
+  }
+
+  if (((flags & osFlagsError) != 0U) || (vsi->Reg_DESCRIPTOR != 0U)) {
+    vsi->Reg_DESCRIPTOR = 0U;
+    return VIDEO_DRV_ERROR;
+  }
+
+  return VIDEO_DRV_OK;
+}
+
+// Register filename one character at a time
+static void Video_SetFileRegs (uint32_t channel, const char *name) {
+  const char    *p;
+        uint32_t n;
+
+  n = strlen(name);
+  Video[channel].vsi->Reg_FILENAME_LEN = n;
+  for (p = name; n != 0U; n--) {
+    Video[channel].vsi->Reg_FILENAME_CHAR = *p++;
+  }
 }
-#endif
 
 // Initialize Video Interface
 int32_t VideoDrv_Initialize (VideoDrv_Event_t cb_event) {
+  uint32_t channel;
 
   CB_Event = cb_event;
 
-  // Initialize Video Input channel 0
-  #if (VIDEO_INPUT_CHANNELS >= 1)
-    VideoI0->Timer.Control = 0U;
-    VideoI0->DMA.Control   = 0U;
-    VideoI0->IRQ.Clear     = Reg_IRQ_Status_Msk;
-    VideoI0->IRQ.Enable    = Reg_IRQ_Status_Msk;
-    VideoI0->Reg_MODE      = Reg_MODE_Input;
-    VideoI0->Reg_CONTROL   = 0U;
-    NVIC_EnableIRQ(VideoI0_IRQn);
-//    NVIC->ISER[(((uint32_t)VideoI0_IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)VideoI0_IRQn) & 0x1FUL));
-  #endif
-  Configured[0] = 0U;
-
-  // Initialize Video Output channel 0
-  #if (VIDEO_OUTPUT_CHANNELS >= 1)
-    VideoO0->Timer.Control = 0U;
-    VideoO0->DMA.Control   = 0U;
-    VideoO0->IRQ.Clear     = Reg_IRQ_Status_Msk;
-    VideoO0->IRQ.Enable    = Reg_IRQ_Status_Msk;
-    VideoO0->Reg_MODE      = Reg_MODE_Output;
-    VideoO0->Reg_CONTROL   = 0U;
-    NVIC_EnableIRQ(VideoO0_IRQn);
-
-//    NVIC->ISER[(((uint32_t)VideoO0_IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)VideoO0_IRQn) & 0x1FUL));
-  #endif
-  Configured[1] = 0U;
-
-  // Initialize Video Input channel 1
-  #if (VIDEO_INPUT_CHANNELS >= 2)
-    VideoI1->Timer.Control = 0U;
-    VideoI1->DMA.Control   = 0U;
-    VideoI1->IRQ.Clear     = Reg_IRQ_Status_Msk;
-    VideoI1->IRQ.Enable    = Reg_IRQ_Status_Msk;
-    VideoI1->Reg_MODE      = Reg_MODE_Input;
-    VideoI1->Reg_CONTROL   = 0U;
-    NVIC_EnableIRQ(VideoI1_IRQn);
-//    NVIC->ISER[(((uint32_t)VideoI1_IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)VideoI1_IRQn) & 0x1FUL));
-  #endif
-  Configured[2] = 0U;
-
-  // Initialize Video Output channel 1
-  #if (VIDEO_OUTPUT_CHANNELS >= 2)
-    VideoO1->Timer.Control = 0U;
-    VideoO1->DMA.Control   = 0U;
-    VideoO1->IRQ.Clear     = Reg_IRQ_Status_Msk;
-    VideoO1->IRQ.Enable    = Reg_IRQ_Status_Msk;
-    VideoO1->Reg_MODE      = Reg_MODE_Output;
-    VideoO1->Reg_CONTROL   = 0U;
-    NVIC_EnableIRQ(VideoO1_IRQn);
-//    NVIC->ISER[(((uint32_t)VideoO1_IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)VideoO1_IRQn) & 0x1FUL));
-  #endif
-  Configured[3] = 0U;
-
-  __DSB();
-  __ISB();
+  if (FrameEvent == NULL) {
+    FrameEvent = osEventFlagsNew(NULL);
+    if (FrameEvent == NULL) {
+      return VIDEO_DRV_ERROR;
+    }
+  }
+  FrameWait = 0U;
+  StreamEnd = 0U;
+
+  for (channel = 0U; channel < 4U; channel++) {
+    Configured[channel]   = 0U;
+    ChannelEvent[channel] = NULL;
+    if (!VIDEO_CHANNEL_VALID(channel)) {
+      continue;
+    }
+    if (VSI_Stream_Bind(&Video[channel], VideoVSI[channel], Reg_IRQ_Status_Msk, Video_Handler, NULL) != VSI_STREAM_OK) {
+      return VIDEO_DRV_ERROR;
+    }
+    if ((channel & 1U) == 0U) {
+      Video[channel].vsi->Reg_MODE = Reg_MODE_Input;
+    } else {
+      Video[channel].vsi->Reg_MODE = Reg_MODE_Output;
+    }
+    Video[channel].vsi->Reg_CONTROL = 0U;
+  }
 
   Initialized = 1U;
 
@@ -255,57 +366,15 @@ int32_t VideoDrv_Initialize (VideoDrv_Event_t cb_event) {
 
 // De-initialize Video Interface
 int32_t VideoDrv_Uninitialize (void) {
+  uint32_t channel;
 
-  // De-initialize Video Input channel 0
-  #if (VIDEO_INPUT_CHANNELS >= 1)
-    NVIC_DisableIRQ(VideoI0_IRQn);
-//    NVIC->ICER[(((uint32_t)VideoI0_IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)VideoI0_IRQn) & 0x1FUL));
-
-    VideoI0->Timer.Control = 0U;
-    VideoI0->DMA.Control   = 0U;
-    VideoI0->IRQ.Clear     = Reg_IRQ_Status_Msk;
-    VideoI0->IRQ.Enable    = 0U;
-    VideoI0->Reg_CONTROL   = 0U;
-  #endif
-
-  // De-initialize Video Output channel 0
-  #if (VIDEO_OUTPUT_CHANNELS >= 1)
-    NVIC_DisableIRQ(VideoO0_IRQn);
-//    NVIC->ICER[(((uint32_t)VideoO0_IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)VideoO0_IRQn) & 0x1FUL));
-
-    VideoO0->Timer.Control = 0U;
-    VideoO0->DMA.Control   = 0U;
-    VideoO0->IRQ.Clear     = Reg_IRQ_Status_Msk;
-    VideoO0->IRQ.Enable    = 0U;
-    VideoO0->Reg_CONTROL   = 0U;
-  #endif
-
-  // De-initialize Video Input channel 1
-  #if (VIDEO_INPUT_CHANNELS >= 2)
-    NVIC_DisableIRQ(VideoI1_IRQn);
-//    NVIC->ICER[(((uint32_t)VideoI1_IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)VideoI1_IRQn) & 0x1FUL));
-  
-    VideoI1->Timer.Control = 0U;
-    VideoI1->DMA.Control   = 0U;
-    VideoI1->IRQ.Clear     = Reg_IRQ_Status_Msk;
-    VideoI1->IRQ.Enable    = 0U;
-    VideoI1->Reg_CONTROL   = 0U;
-  #endif
-
-  // De-initialize Video Output channel 1
-  #if (VIDEO_OUTPUT_CHANNELS >= 2)
-    NVIC_DisableIRQ(VideoO1_IRQn);
-//    NVIC->ICER[(((uint32_t)VideoO1_IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)VideoO1_IRQn) & 0x1FUL));
-
-    VideoO1->Timer.Control = 0U;
-    VideoO1->DMA.Control   = 0U;
-    VideoO1->IRQ.Clear     = Reg_IRQ_Status_Msk;
-    VideoO1->IRQ.Enable    = 0U;
-    VideoO1->Reg_CONTROL   = 0U;
-  #endif
-
-  __DSB();
-  __ISB();
+  for (channel = 0U; channel < 4U; channel++) {
+    if (!VIDEO_CHANNEL_VALID(channel)) {
+      continue;
+    }
+    VSI_Stream_Unbind(&Video[channel]);
+    Video[channel].vsi->Reg_CONTROL = 0U;
+  }
 
   Initialized = 0U;
 
@@ -314,11 +383,10 @@ int32_t VideoDrv_Uninitialize (void) {
 
 // Set Video Interface file
 int32_t VideoDrv_SetFile (uint32_t channel, const char *name) {
-  const char    *p;
-        uint32_t n;
+  uint32_t desc[VIDEO_DESC_SIZE / 4U];
+  uint32_t pos;
 
-  if ((((channel & 1U) == 0U) && ((channel >> 1) >= VIDEO_INPUT_CHANNELS))  ||
-      (((channel & 1U) != 0U) && ((channel >> 1) >= VIDEO_OUTPUT_CHANNELS)) ||
+  if (!VIDEO_CHANNEL_VALID(channel) ||
       (name == NULL)) {
     return VIDEO_DRV_ERROR_PARAMETER;
   }
@@ -327,17 +395,16 @@ int32_t VideoDrv_SetFile (uint32_t channel, const char *name) {
     return VIDEO_DRV_ERROR;
   }
 
-  if ((pVideo[channel]->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) != 0U) {
+  if ((Video[channel].vsi->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) != 0U) {
     return VIDEO_DRV_ERROR;
   }
 
-  // Register Video filename
-  n = strlen(name);
-  pVideo[channel]->Reg_FILENAME_LEN = n;
-  for (p = name; n != 0U; n--) {
-    pVideo[channel]->Reg_FILENAME_CHAR = *p++;
+  // Register Video filename: one descriptor block, per character registers as fallback
+  pos = Video_DescAdd(desc, 0U, VIDEO_DESC_FILENAME, name, strlen(name));
+  if ((pos == 0U) || (Video_SendDescriptor(channel, desc, pos) != VIDEO_DRV_OK)) {
+    Video_SetFileRegs(channel, name);
   }
-  if (pVideo[channel]->Reg_FILENAME_VALID == 0U) {
+  if (Video[channel].vsi->Reg_FILENAME_VALID == 0U) {
     return VIDEO_DRV_ERROR;
   }
 
@@ -346,11 +413,9 @@ int32_t VideoDrv_SetFile (uint32_t channel, const char *name) {
 
 // Configure Video Interface
 int32_t VideoDrv_Configure (uint32_t channel, uint32_t frame_width, uint32_t frame_height, uint32_t color_format, uint32_t frame_rate) {
-  uint32_t pixel_size;
   uint32_t block_size;
 
-  if ((((channel & 1U) == 0U) && ((channel >> 1) >= VIDEO_INPUT_CHANNELS))  ||
-      (((channel & 1U) != 0U) && ((channel >> 1) >= VIDEO_OUTPUT_CHANNELS)) ||
+  if (!VIDEO_CHANNEL_VALID(channel) ||
       (frame_width  == 0U) ||
       (frame_height == 0U) ||
       (frame_rate   == 0U) ||
@@ -359,54 +424,124 @@ int32_t VideoDrv_Configure (uint32_t channel, uint32_t frame_width, uint32_t fra
     return VIDEO_DRV_ERROR_PARAMETER;
   }
 
-  switch (color_format) {
-    case VIDEO_DRV_COLOR_GRAYSCALE8:
-      pixel_size = 8U;
-      break;
-    case VIDEO_DRV_COLOR_YUV420:
-      pixel_size = 12U;
-      break;
-    case VIDEO_DRV_COLOR_BGR565:
-      pixel_size = 16U;
-      break;
-    case VIDEO_DRV_COLOR_RGB888:
-    case VIDEO_DRV_COLOR_NV12:
-    case VIDEO_DRV_COLOR_NV21:
-      pixel_size = 24U;
-      break;
-    default:
-      return VIDEO_DRV_ERROR_PARAMETER;
+  block_size = Video_FrameSize(frame_width, frame_height, color_format);
+  if (block_size == 0U) {
+    return VIDEO_DRV_ERROR_PARAMETER;
   }
 
-  block_size = (((frame_width * frame_height) * pixel_size) + 7U) / 8U;
-  block_size = (block_size + 3U) & ~3U;
-
   if (Initialized == 0U) {
     return VIDEO_DRV_ERROR;
   }
 
-  if ((pVideo[channel]->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) != 0U) {
+  if ((Video[channel].vsi->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) != 0U) {
     return VIDEO_DRV_ERROR;
   }
 
-  pVideo[channel]->Reg_FRAME_WIDTH  = frame_width;
-  pVideo[channel]->Reg_FRAME_HEIGHT = frame_height;
-  pVideo[channel]->Reg_COLOR_FORMAT = color_format;
-  pVideo[channel]->Reg_FRAME_RATE   = frame_rate;
-  pVideo[channel]->Timer.Interval   = 1000000U / frame_rate;
-  pVideo[channel]->DMA.BlockSize    = block_size;
+  Video[channel].vsi->Reg_FRAME_WIDTH  = frame_width;
+  Video[channel].vsi->Reg_FRAME_HEIGHT = frame_height;
+  Video[channel].vsi->Reg_COLOR_FORMAT = color_format;
+  Video[channel].vsi->Reg_FRAME_RATE   = frame_rate;
+  Video[channel].vsi->Reg_FRAME_RATE_DEN = 1U;
+  VSI_Stream_SetPeriod(&Video[channel], 1000000ULL, frame_rate, 1U);
+  FrameSize[channel] = block_size;
 
   Configured[channel] = 1U;
 
   return VIDEO_DRV_OK;
 }
 
+// Set Video Interface file and configuration
+int32_t VideoDrv_SetStream (uint32_t channel, const char *name, uint32_t frame_width, uint32_t frame_height, uint32_t color_format, uint32_t frame_rate) {
+  uint32_t desc[VIDEO_DESC_SIZE / 4U];
+  uint32_t pos;
+  uint32_t block_size;
+
+  if (!VIDEO_CHANNEL_VALID(channel) ||
+      (name         == NULL) ||
+      (frame_width  == 0U) ||
+      (frame_height == 0U) ||
+      (frame_rate   == 0U) ||
+      (color_format <= VIDEO_DRV_COLOR_FORMAT_BEGIN) ||
+      (color_format >= VIDEO_DRV_COLOR_FORMAT_END)) {
+    return VIDEO_DRV_ERROR_PARAMETER;
+  }
+
+  block_size = Video_FrameSize(frame_width, frame_height, color_format);
+  if (block_size == 0U) {
+    return VIDEO_DRV_ERROR_PARAMETER;
+  }
+
+  if (Initialized == 0U) {
+    return VIDEO_DRV_ERROR;
+  }
+
+  if ((Video[channel].vsi->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) != 0U) {
+    return VIDEO_DRV_ERROR;
+  }
+
+  // Stream parameters before the filename, the model checks the file with the new parameters
+  pos = Video_DescAddParam(desc, 0U, VIDEO_DESC_FRAME_WIDTH,  frame_width);
+  pos = Video_DescAddParam(desc, pos, VIDEO_DESC_FRAME_HEIGHT, frame_height);
+  pos = Video_DescAddParam(desc, pos, VIDEO_DESC_COLOR_FORMAT, color_format);
+  pos = Video_DescAddParam(desc, pos, VIDEO_DESC_FRAME_RATE,   frame_rate);
+  pos = Video_DescAddParam(desc, pos, VIDEO_DESC_FRAME_RATE_DEN, 1U);
+  pos = Video_DescAdd(desc, pos, VIDEO_DESC_FILENAME, name, strlen(name));
+  if ((pos == 0U) || (Video_SendDescriptor(channel, desc, pos) != VIDEO_DRV_OK)) {
+    Video[channel].vsi->Reg_FRAME_WIDTH  = frame_width;
+    Video[channel].vsi->Reg_FRAME_HEIGHT = frame_height;
+    Video[channel].vsi->Reg_COLOR_FORMAT = color_format;
+    Video[channel].vsi->Reg_FRAME_RATE   = frame_rate;
+    Video[channel].vsi->Reg_FRAME_RATE_DEN = 1U;
+    Video_SetFileRegs(channel, name);
+  }
+
+  VSI_Stream_SetPeriod(&Video[channel], 1000000ULL, frame_rate, 1U);
+
+  // Buffer remains set when the frame size is unchanged
+  if ((Configured[channel] < 2U) || (block_size != FrameSize[channel])) {
+    Configured[channel] = 1U;
+  }
+  FrameSize[channel] = block_size;
+
+  if (Video[channel].vsi->Reg_FILENAME_VALID == 0U) {
+    return VIDEO_DRV_ERROR;
+  }
+
+  return VIDEO_DRV_OK;
+}
+
+// Set Video Interface frame rate (rate_num/rate_den frames per second)
+int32_t VideoDrv_SetFrameRate (uint32_t channel, uint32_t rate_num, uint32_t rate_den) {
+
+  if (!VIDEO_CHANNEL_VALID(channel) ||
+      (rate_num == 0U) ||
+      (rate_den == 0U)) {
+    return VIDEO_DRV_ERROR_PARAMETER;
+  }
+
+  if ((Initialized         == 0U) ||
+      (Configured[channel] == 0U)) {
+    return VIDEO_DRV_ERROR;
+  }
+
+  if ((Video[channel].vsi->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) != 0U) {
+    return VIDEO_DRV_ERROR;
+  }
+
+  Video[channel].vsi->Reg_FRAME_RATE     = rate_num;
+  Video[channel].vsi->Reg_FRAME_RATE_DEN = rate_den;
+
+  // Frame period rate_den/rate_num seconds, fractional pacing keeps the frame timing drift-free
+  VSI_Stream_SetPeriod(&Video[channel], 1000000ULL * rate_den, rate_num, 1U);
+
+  return VIDEO_DRV_OK;
+}
+
 // Set Video Interface buffer
 int32_t VideoDrv_SetBuf (uint32_t channel, void *buf, uint32_t buf_size) {
   uint32_t block_num;
 
-   if ((((channel & 1U) == 0U) && ((channel >> 1) >= VIDEO_INPUT_CHANNELS))  ||
-       (((channel & 1U) != 0U) && ((channel >> 1) >= VIDEO_OUTPUT_CHANNELS)) ||
+   if (!VIDEO_CHANNEL_VALID(channel) ||
        (buf      == NULL) ||
        (buf_size == 0U)) {
      return VIDEO_DRV_ERROR_PARAMETER;
@@ -417,19 +552,29 @@ int32_t VideoDrv_SetBuf (uint32_t channel, void *buf, uint32_t buf_size) {
      return VIDEO_DRV_ERROR;
    }
 
-   if ((pVideo[channel]->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) != 0U) {
+   if ((Video[channel].vsi->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) != 0U) {
      return VIDEO_DRV_ERROR;
    }
 
-   block_num = buf_size / pVideo[channel]->DMA.BlockSize;
+   block_num = buf_size / FrameSize[channel];
    if (block_num == 0U) {
      return VIDEO_DRV_ERROR;
    }
+   if (block_num > VIDEO_DRV_FRAMES_MAX) {
+     block_num = VIDEO_DRV_FRAMES_MAX;
+   }
 
-   pVideo[channel]->Reg_FRAME_COUNT_MAX = block_num;
-   pVideo[channel]->DMA.BlockNum        = block_num;
+   // DMA requires 2^n blocks
+   while ((block_num & (block_num - 1U)) != 0U) {
+     block_num &= block_num - 1U;
+   }
 
-   pVideo[channel]->DMA.Address = (uint32_t)buf;
+   if (VSI_Stream_SetBuf(&Video[channel], buf, block_num, FrameSize[channel]) != VSI_STREAM_OK) {
+     return VIDEO_DRV_ERROR;
+   }
+
+   Video[channel].vsi->Reg_FRAME_COUNT_MAX = block_num;
+   Video_QueueReset(channel);
 
   Configured[channel] = 2U;
 
@@ -439,8 +584,7 @@ int32_t VideoDrv_SetBuf (uint32_t channel, void *buf, uint32_t buf_size) {
 // Flush Video Interface buffer
 int32_t VideoDrv_FlushBuf (uint32_t channel) {
 
-  if ((((channel & 1U) == 0U) && ((channel >> 1) >= VIDEO_INPUT_CHANNELS))  ||
-      (((channel & 1U) != 0U) && ((channel >> 1) >= VIDEO_OUTPUT_CHANNELS))) {
+  if (!VIDEO_CHANNEL_VALID(channel)) {
     return VIDEO_DRV_ERROR_PARAMETER;
   }
 
@@ -448,11 +592,12 @@ int32_t VideoDrv_FlushBuf (uint32_t channel) {
     return VIDEO_DRV_ERROR;
   }
 
-  if ((pVideo[channel]->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) != 0U) {
+  if ((Video[channel].vsi->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) != 0U) {
     return VIDEO_DRV_ERROR;
   }
 
-  pVideo[channel]->Reg_CONTROL = Reg_CONTROL_BUF_FLUSH_Msk;
+  Video[channel].vsi->Reg_CONTROL = Reg_CONTROL_BUF_FLUSH_Msk;
+  Video_QueueReset(channel);
 
   return VIDEO_DRV_OK;
 }
@@ -460,9 +605,9 @@ int32_t VideoDrv_FlushBuf (uint32_t channel) {
 // Start Stream on Video Interface
 int32_t VideoDrv_StreamStart (uint32_t channel, uint32_t mode) {
   uint32_t control;
+  uint32_t primask;
 
-  if ((((channel & 1U) == 0U) && ((channel >> 1) >= VIDEO_INPUT_CHANNELS))  ||
-      (((channel & 1U) != 0U) && ((channel >> 1) >= VIDEO_OUTPUT_CHANNELS)) ||
+  if (!VIDEO_CHANNEL_VALID(channel) ||
       (mode > VIDEO_DRV_MODE_CONTINUOS)) {
     return VIDEO_DRV_ERROR_PARAMETER;
   }
@@ -472,7 +617,7 @@ int32_t VideoDrv_StreamStart (uint32_t channel, uint32_t mode) {
     return VIDEO_DRV_ERROR;
   }
 
-  if ((pVideo[channel]->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) != 0U) {
+  if ((Video[channel].vsi->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) != 0U) {
     return VIDEO_DRV_OK;
   }
 
@@ -480,36 +625,30 @@ int32_t VideoDrv_StreamStart (uint32_t channel, uint32_t mode) {
   if (mode == VIDEO_DRV_MODE_CONTINUOS) {
     control |= Reg_CONTROL_CONTINUOS_Msk;
   }
-  pVideo[channel]->Reg_CONTROL = control;
+  primask = __get_PRIMASK();
+  __disable_irq();
+  StreamEnd &= ~(1U << channel);
+  Video_QueueSync(channel);
+  __set_PRIMASK(primask);
 
-  if ((pVideo[channel]->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) == 0U) {
-    return VIDEO_DRV_ERROR;
-  }
+  Video[channel].vsi->Reg_CONTROL = control;
 
-  control = ARM_VSI_DMA_Enable_Msk;
-  if ((channel & 1U) == 0U) {
-    control |= ARM_VSI_DMA_Direction_P2M;
-  } else {
-    control |= ARM_VSI_DMA_Direction_M2P;
+  if ((Video[channel].vsi->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) == 0U) {
+    return VIDEO_DRV_ERROR;
   }
-  pVideo[channel]->DMA.Control = control;
 
-  control = ARM_VSI_Timer_Run_Msk      |
-            ARM_VSI_Timer_Trig_DMA_Msk |
-            ARM_VSI_Timer_Trig_IRQ_Msk;
-  if (mode == VIDEO_DRV_MODE_CONTINUOS) {
-    control |= ARM_VSI_Timer_Periodic_Msk;
-  }
-  pVideo[channel]->Timer.Control = control;
+  VSI_Stream_Start(&Video[channel],
+                   VIDEO_CHANNEL_INPUT(channel) ? VSI_STREAM_INPUT : VSI_STREAM_OUTPUT,
+                   (mode == VIDEO_DRV_MODE_CONTINUOS) ? VSI_STREAM_PERIODIC : VSI_STREAM_SINGLE);
 
   return VIDEO_DRV_OK;
 }
 
 // Stop Stream on Video Interface
 int32_t VideoDrv_StreamStop (uint32_t channel) {
+  uint32_t primask;
 
-  if ((((channel & 1U) == 0U) && ((channel >> 1) >= VIDEO_INPUT_CHANNELS))  ||
-      (((channel & 1U) != 0U) && ((channel >> 1) >= VIDEO_OUTPUT_CHANNELS))) {
+  if (!VIDEO_CHANNEL_VALID(channel)) {
     return VIDEO_DRV_ERROR_PARAMETER;
   }
 
@@ -518,13 +657,22 @@ int32_t VideoDrv_StreamStop (uint32_t channel) {
     return VIDEO_DRV_ERROR;
   }
 
-  if ((pVideo[channel]->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) == 0U) {
+  if ((Video[channel].vsi->Reg_STATUS & Reg_STATUS_ACTIVE_Msk) == 0U) {
     return VIDEO_DRV_OK;
   }
 
-  pVideo[channel]->Timer.Control = 0U;
-  pVideo[channel]->DMA.Control   = 0U;
-  pVideo[channel]->Reg_CONTROL   = 0U;
+  VSI_Stream_Stop(&Video[channel]);
+  Video[channel].vsi->Reg_CONTROL = 0U;
+
+  // Release thread waiting for a frame
+  primask = __get_PRIMASK();
+  __disable_irq();
+  StreamEnd |= 1U << channel;
+  if ((FrameWait & (1U << channel)) != 0U) {
+    FrameWait &= ~(1U << channel);
+    osEventFlagsSet(FrameEvent, 1U << channel);
+  }
+  __set_PRIMASK(primask);
 
   return VIDEO_DRV_OK;
 }
@@ -533,8 +681,7 @@ int32_t VideoDrv_StreamStop (uint32_t channel) {
 void *VideoDrv_GetFrameBuf (uint32_t channel) {
   void *frame = NULL;
 
-  if ((((channel & 1U) == 0U) && ((channel >> 1) >= VIDEO_INPUT_CHANNELS))  ||
-      (((channel & 1U) != 0U) && ((channel >> 1) >= VIDEO_OUTPUT_CHANNELS))) {
+  if (!VIDEO_CHANNEL_VALID(channel)) {
     return NULL;
   }
 
@@ -543,28 +690,21 @@ void *VideoDrv_GetFrameBuf (uint32_t channel) {
     return NULL;
   }
 
-  if ((pVideo[channel]->Reg_MODE & Reg_MODE_IO_Msk) == Reg_MODE_Input) {
-    // Input
-    if ((pVideo[channel]->Reg_STATUS & Reg_STATUS_BUF_EMPTY_Msk) != 0U) {
-      return NULL;
-    }
-  } else {
-    // Output
-    if ((pVideo[channel]->Reg_STATUS & Reg_STATUS_BUF_FULL_Msk) != 0U) {
-      return NULL;
-    }
+  // Input buffer empty or output buffer full
+  if (Queue[channel].frames == 0U) {
+    return NULL;
   }
 
-  frame = (void *)(pVideo[channel]->DMA.Address + (pVideo[channel]->Reg_FRAME_INDEX * pVideo[channel]->DMA.BlockSize));
+  frame = (void *)(Video[channel].buf + (Queue[channel].index * FrameSize[channel]));
 
   return frame;
 }
 
 // Release Video Frame
 int32_t VideoDrv_ReleaseFrame (uint32_t channel) {
+  uint32_t primask;
 
-  if ((((channel & 1U) == 0U) && ((channel >> 1) >= VIDEO_INPUT_CHANNELS))  ||
-      (((channel & 1U) != 0U) && ((channel >> 1) >= VIDEO_OUTPUT_CHANNELS))) {
+  if (!VIDEO_CHANNEL_VALID(channel)) {
     return VIDEO_DRV_ERROR_PARAMETER;
   }
 
@@ -573,32 +713,172 @@ int32_t VideoDrv_ReleaseFrame (uint32_t channel) {
     return VIDEO_DRV_ERROR;
   }
 
-  if ((pVideo[channel]->Reg_MODE & Reg_MODE_IO_Msk) == Reg_MODE_Input) {
-    // Input
-    if ((pVideo[channel]->Reg_STATUS & Reg_STATUS_BUF_EMPTY_Msk) != 0U) {
-      return VIDEO_DRV_ERROR;
-    }
-  } else {
-    // Output
-    if ((pVideo[channel]->Reg_STATUS & Reg_STATUS_BUF_FULL_Msk) != 0U) {
-      return VIDEO_DRV_ERROR;
-    }
+  primask = __get_PRIMASK();
+  __disable_irq();
+
+  // Input buffer empty or output buffer full
+  if (Queue[channel].frames == 0U) {
+    __set_PRIMASK(primask);
+    return VIDEO_DRV_ERROR;
   }
 
-  pVideo[channel]->Reg_FRAME_INDEX = 0U;
+  Video_QueueRelease(channel);
+
+  __set_PRIMASK(primask);
 
   return VIDEO_DRV_OK;
 }
 
+// Acquire Video Frame
+int32_t VideoDrv_AcquireFrame (uint32_t channel, void **frame) {
+  uint32_t primask;
+  uint32_t index;
+
+  if (!VIDEO_CHANNEL_VALID(channel) ||
+      (frame == NULL)) {
+    return VIDEO_DRV_ERROR_PARAMETER;
+  }
+
+  *frame = NULL;
+
+  if ((Initialized         == 0U) ||
+      (Configured[channel] <  2U)) {
+    return VIDEO_DRV_ERROR;
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+
+  if (Video_FramesAvailable(channel) == 0U) {
+    __set_PRIMASK(primask);
+    return VIDEO_DRV_ERROR_BUSY;
+  }
+
+  // Next frame after the ones already held
+  index = (Queue[channel].index + Queue[channel].count) & (Video[channel].block_num - 1U);
+  Queue[channel].acquired |= 1U << index;
+  Queue[channel].count++;
+
+  __set_PRIMASK(primask);
+
+  *frame = (void *)(Video[channel].buf + (index * FrameSize[channel]));
+
+  return (int32_t)index;
+}
+
+// Release Video Frame acquired with VideoDrv_AcquireFrame
+int32_t VideoDrv_ReleaseFrameHandle (uint32_t channel, int32_t handle) {
+  uint32_t primask;
+  uint32_t index;
+
+  if (!VIDEO_CHANNEL_VALID(channel) ||
+      (handle < 0) ||
+      ((uint32_t)handle >= VIDEO_DRV_FRAMES_MAX)) {
+    return VIDEO_DRV_ERROR_PARAMETER;
+  }
+
+  if ((Initialized         == 0U) ||
+      (Configured[channel] <  2U)) {
+    return VIDEO_DRV_ERROR;
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+
+  index = (uint32_t)handle;
+  if (((Queue[channel].acquired & ~Queue[channel].released) & (1U << index)) == 0U) {
+    // Frame not held by the application
+    __set_PRIMASK(primask);
+    return VIDEO_DRV_ERROR_PARAMETER;
+  }
+  Queue[channel].released |= 1U << index;
+
+  // Return released frames to the peripheral in acquire order
+  index = Queue[channel].index;
+  while ((Queue[channel].released & (1U << index)) != 0U) {
+    Queue[channel].released &= ~(1U << index);
+    Queue[channel].acquired &= ~(1U << index);
+    Queue[channel].count--;
+    Video_QueueRelease(channel);
+    index = Queue[channel].index;
+  }
+
+  __set_PRIMASK(primask);
+
+  return VIDEO_DRV_OK;
+}
+
+// Wait for Video Frame
+int32_t VideoDrv_WaitFrame (uint32_t channel, uint32_t timeout) {
+  uint32_t primask;
+  uint32_t mask;
+
+  if (!VIDEO_CHANNEL_VALID(channel)) {
+    return VIDEO_DRV_ERROR_PARAMETER;
+  }
+
+  if ((Initialized         == 0U) ||
+      (Configured[channel] <  2U)) {
+    return VIDEO_DRV_ERROR;
+  }
+
+  mask = 1U << channel;
+  osEventFlagsClear(FrameEvent, mask);
+
+  // Publish wait before checking, so that a frame completing in between wakes the thread
+  primask = __get_PRIMASK();
+  __disable_irq();
+  FrameWait |= mask;
+  __set_PRIMASK(primask);
+
+  if ((Video_FramesAvailable(channel) == 0U) && ((StreamEnd & mask) == 0U)) {
+    osEventFlagsWait(FrameEvent, mask, osFlagsWaitAny, timeout);
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  FrameWait &= ~mask;
+  __set_PRIMASK(primask);
+
+  if (Video_FramesAvailable(channel) != 0U) {
+    return VIDEO_DRV_OK;
+  }
+  if ((StreamEnd & mask) != 0U) {
+    return VIDEO_DRV_ERROR;
+  }
+
+  return VIDEO_DRV_ERROR_TIMEOUT;
+}
+
+// Set Video channel event flags
+int32_t VideoDrv_SetEventFlags (uint32_t channel, void *ef_id, uint32_t flags) {
+  uint32_t primask;
+
+  if (!VIDEO_CHANNEL_VALID(channel) ||
+      ((ef_id != NULL) && ((flags == 0U) || ((flags & 0x80000000U) != 0U)))) {
+    return VIDEO_DRV_ERROR_PARAMETER;
+  }
+
+  if (Initialized == 0U) {
+    return VIDEO_DRV_ERROR;
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  ChannelEvent[channel] = (osEventFlagsId_t)ef_id;
+  ChannelFlags[channel] = flags;
+  __set_PRIMASK(primask);
+
+  return VIDEO_DRV_OK;
+}
 
 // Get Video Interface status
 VideoDrv_Status_t VideoDrv_GetStatus (uint32_t channel) {
   VideoDrv_Status_t status = { 0U, 0U, 0U, 0U, 0U, 0U, 0U };
   uint32_t          status_reg;
 
-  if ((((channel & 1U) == 0U) && ((channel >> 1) < VIDEO_INPUT_CHANNELS))  ||
-      (((channel & 1U) != 0U) && ((channel >> 1) < VIDEO_OUTPUT_CHANNELS))) {
-    status_reg       =  pVideo[channel]->Reg_STATUS;
+  if (VIDEO_CHANNEL_VALID(channel) && (Initialized != 0U)) {
+    status_reg       =  Video[channel].vsi->Reg_STATUS;
     status.active    = (status_reg & Reg_STATUS_ACTIVE_Msk)    >> Reg_STATUS_ACTIVE_Pos;
     status.buf_empty = (status_reg & Reg_STATUS_BUF_EMPTY_Msk) >> Reg_STATUS_BUF_EMPTY_Pos;
     status.buf_full  = (status_reg & Reg_STATUS_BUF_FULL_Msk)  >> Reg_STATUS_BUF_FULL_Pos;
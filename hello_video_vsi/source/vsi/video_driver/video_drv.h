@@ -41,13 +41,13 @@ extern "C"
 #define VIDEO_DRV_COLOR_RGB888          (2UL)       ///< 24 bit RGB color format
 #define VIDEO_DRV_COLOR_BGR565          (3UL)       ///< 16 bit BGR color format
 #define VIDEO_DRV_COLOR_YUV420          (4UL)       ///< 12 bit YUV420 color format
-#define VIDEO_DRV_COLOR_NV12            (5UL)       ///< 24 bit NV12 color format
-#define VIDEO_DRV_COLOR_NV21            (6UL)       ///< 24 bit NV12 color format
+#define VIDEO_DRV_COLOR_NV12            (5UL)       ///< 12 bit NV12 color format (Y plane, interleaved UV)
+#define VIDEO_DRV_COLOR_NV21            (6UL)       ///< 12 bit NV21 color format (Y plane, interleaved VU)
 #define VIDEO_DRV_COLOR_FORMAT_END      (7UL)       ///< Color format end
 
 /* Video Event */
 #define VIDEO_DRV_EVENT_FRAME           (1UL << 0)  ///< Video frame received
-#define VIDEO_DRV_EVENT_OVERFLOW        (1UL << 1)  ///< Video buffer overflow
+#define VIDEO_DRV_EVENT_OVERFLOW        (1UL << 1)  ///< Video buffer overflow or output frame dropped
 #define VIDEO_DRV_EVENT_UNDERFLOW       (1UL << 2)  ///< Video buffer underflow
 #define VIDEO_DRV_EVENT_EOS             (1UL << 3)  ///< Video end of stream
 
@@ -55,13 +55,18 @@ extern "C"
 #define VIDEO_DRV_OK                    (0)         ///< Operation succeeded
 #define VIDEO_DRV_ERROR                 (-1)        ///< Unspecified error
 #define VIDEO_DRV_ERROR_PARAMETER       (-2)        ///< Parameter error
+#define VIDEO_DRV_ERROR_BUSY            (-3)        ///< No frame available
+#define VIDEO_DRV_ERROR_TIMEOUT         (-4)        ///< Timeout occurred
+
+/* Video Frame queue */
+#define VIDEO_DRV_FRAMES_MAX            (32UL)      ///< Maximum number of frames in channel buffer
 
 /// Video Status
 typedef struct {
   uint32_t active       :  1;           ///< Video stream active
   uint32_t buf_empty    :  1;           ///< Video buffer empty
   uint32_t buf_full     :  1;           ///< Video buffer full
-  uint32_t overflow     :  1;           ///< Video buffer overflow (cleared on GetStatus)
+  uint32_t overflow     :  1;           ///< Video buffer overflow or output frame dropped (cleared on GetStatus)
   uint32_t underflow    :  1;           ///< Video buffer underflow (cleared on GetStatus)
   uint32_t eos          :  1;           ///< Video end of stream (cleared on GetStatus)
   uint32_t reserved     : 26;
@@ -97,7 +102,30 @@ int32_t VideoDrv_SetFile (uint32_t channel, const char *name);
 /// \return      return code
 int32_t VideoDrv_Configure (uint32_t channel, uint32_t frame_width, uint32_t frame_height, uint32_t color_format, uint32_t frame_rate);
 
+/// \brief       Set Video channel file and configuration.
+///              Filename and stream parameters are transferred to the peripheral in one
+///              descriptor block. The buffer set with \ref VideoDrv_SetBuf remains valid when
+///              the frame size is unchanged, otherwise the buffer must be set again.
+/// \param[in]   channel        channel number
+/// \param[in]   name           video filename (pointer to NULL terminated string)
+/// \param[in]   frame_width    frame width in pixels
+/// \param[in]   frame_height   frame height in pixels
+/// \param[in]   color_format   pixel color format
+/// \param[in]   frame_rate     frame rate (frames per second)
+/// \return      return code
+int32_t VideoDrv_SetStream (uint32_t channel, const char *name, uint32_t frame_width, uint32_t frame_height, uint32_t color_format, uint32_t frame_rate);
+
+/// \brief       Set Video channel frame rate as rational number (for example 30000/1001).
+///              Call after \ref VideoDrv_Configure or \ref VideoDrv_SetStream while the stream is stopped.
+///              Frames are paced drift-free at the exact rate.
+/// \param[in]   channel        channel number
+/// \param[in]   rate_num       frame rate numerator
+/// \param[in]   rate_den       frame rate denominator
+/// \return      return code
+int32_t VideoDrv_SetFrameRate (uint32_t channel, uint32_t rate_num, uint32_t rate_den);
+
 /// \brief       Set Video channel buffer.
+///              Buffer holds 2^n frames (maximum \ref VIDEO_DRV_FRAMES_MAX), remaining space is unused.
 /// \param[in]   channel        channel number
 /// \param[in]   buf            pointer to buffer for video stream
 /// \param[in]   buf_size       video stream buffer size in bytes
@@ -121,15 +149,52 @@ int32_t VideoDrv_StreamStart (uint32_t channel, uint32_t mode);
 int32_t VideoDrv_StreamStop (uint32_t channel);
 
 /// \brief       Get Video channel Frame buffer.
+///              Single frame access, do not mix with \ref VideoDrv_AcquireFrame on the same channel.
 /// \param[in]   channel        channel number
 /// \return      pointer to frame buffer
 void *VideoDrv_GetFrameBuf (uint32_t channel);
 
 /// \brief       Release Video channel Frame.
+///              Releases the frame returned by \ref VideoDrv_GetFrameBuf.
 /// \param[in]   channel        channel number
 /// \return      return code
 int32_t VideoDrv_ReleaseFrame (uint32_t channel);
 
+/// \brief       Acquire Video channel Frame.
+///              Input: next received frame. Output: next free frame to fill.
+///              Several frames can be held at the same time and released in any order.
+/// \param[in]   channel        channel number
+/// \param[out]  frame          pointer to frame buffer
+/// \return      frame handle (>= 0) or return code (\ref VIDEO_DRV_ERROR_BUSY when no frame is available)
+int32_t VideoDrv_AcquireFrame (uint32_t channel, void **frame);
+
+/// \brief       Release Video channel Frame acquired with \ref VideoDrv_AcquireFrame.
+///              Frames are returned to the peripheral in acquire order: an output frame
+///              is sent once all frames acquired before it have been released.
+/// \param[in]   channel        channel number
+/// \param[in]   handle         frame handle returned by \ref VideoDrv_AcquireFrame
+/// \return      return code
+int32_t VideoDrv_ReleaseFrameHandle (uint32_t channel, int32_t handle);
+
+/// \brief       Wait for Video channel Frame.
+///              Blocks the calling thread until a frame can be acquired with \ref VideoDrv_AcquireFrame
+///              (input: received frame, output: free frame). The thread is woken from the Video
+///              interrupt, the Video registers are not polled. One waiting thread per channel.
+/// \param[in]   channel        channel number
+/// \param[in]   timeout        timeout in kernel ticks (osWaitForever to wait indefinitely)
+/// \return      return code (\ref VIDEO_DRV_ERROR when the stream ended or was stopped,
+///                            \ref VIDEO_DRV_ERROR_TIMEOUT when no frame became available)
+int32_t VideoDrv_WaitFrame (uint32_t channel, uint32_t timeout);
+
+/// \brief       Set Video channel event flags.
+///              On each frame and end of stream event of the channel the flags are set in the
+///              event flags object, so that channels can be served by different threads.
+/// \param[in]   channel        channel number
+/// \param[in]   ef_id          CMSIS-RTOS2 event flags ID (NULL to remove)
+/// \param[in]   flags          flags to set
+/// \return      return code
+int32_t VideoDrv_SetEventFlags (uint32_t channel, void *ef_id, uint32_t flags);
+
 /// \brief       Get Video channel status.
 /// \param[in]   channel        channel number
 /// \return      \ref VideoDrv_Status_t
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ */
+
+/* Generated by vsi_regmap.py from video_regs.json, do not edit */
+
+#ifndef __VIDEO_REGS_H
+#define __VIDEO_REGS_H
+
+/* Video Peripheral registers (VSI user registers) */
+#define Reg_MODE_Idx                    0U
+#define Reg_MODE                        Regs[Reg_MODE_Idx]              /* Mode: 0=Input, 1=Output */
+#define Reg_CONTROL_Idx                 1U
+#define Reg_CONTROL                     Regs[Reg_CONTROL_Idx]           /* Control: enable, continuos, flush */
+#define Reg_STATUS_Idx                  2U
+#define Reg_STATUS                      Regs[Reg_STATUS_Idx]            /* Status: active, buf_empty, buf_full, overflow, underflow, eos, read-only */
+#define Reg_FILENAME_LEN_Idx            3U
+#define Reg_FILENAME_LEN                Regs[Reg_FILENAME_LEN_Idx]      /* Filename length */
+#define Reg_FILENAME_CHAR_Idx           4U
+#define Reg_FILENAME_CHAR               Regs[Reg_FILENAME_CHAR_Idx]     /* Filename character */
+#define Reg_FILENAME_VALID_Idx          5U
+#define Reg_FILENAME_VALID              Regs[Reg_FILENAME_VALID_Idx]    /* Filename valid flag, read-only */
+#define Reg_FRAME_WIDTH_Idx             6U
+#define Reg_FRAME_WIDTH                 Regs[Reg_FRAME_WIDTH_Idx]       /* Requested frame width */
+#define Reg_FRAME_HEIGHT_Idx            7U
+#define Reg_FRAME_HEIGHT                Regs[Reg_FRAME_HEIGHT_Idx]      /* Requested frame height */
+#define Reg_COLOR_FORMAT_Idx            8U
+#define Reg_COLOR_FORMAT                Regs[Reg_COLOR_FORMAT_Idx]      /* Color format */
+#define Reg_FRAME_RATE_Idx              9U
+#define Reg_FRAME_RATE                  Regs[Reg_FRAME_RATE_Idx]        /* Frame rate */
+#define Reg_FRAME_INDEX_Idx             10U
+#define Reg_FRAME_INDEX                 Regs[Reg_FRAME_INDEX_Idx]       /* Frame index (write advances) */
+#define Reg_FRAME_COUNT_Idx             11U
+#define Reg_FRAME_COUNT                 Regs[Reg_FRAME_COUNT_Idx]       /* Frame count, read-only */
+#define Reg_FRAME_COUNT_MAX_Idx         12U
+#define Reg_FRAME_COUNT_MAX             Regs[Reg_FRAME_COUNT_MAX_Idx]   /* Frame count maximum */
+#define Reg_DESCRIPTOR_Idx              13U
+#define Reg_DESCRIPTOR                  Regs[Reg_DESCRIPTOR_Idx]        /* Descriptor size of next DMA block (0 when processed) */
+#define Reg_FRAME_RATE_DEN_Idx          14U
+#define Reg_FRAME_RATE_DEN              Regs[Reg_FRAME_RATE_DEN_Idx]    /* Frame rate denominator (FRAME_RATE/FRAME_RATE_DEN, 0=1) */
+
+/* Video MODE register definitions */
+#define Reg_MODE_IO_Pos                 0U                              /* MODE: Input/Output */
+#define Reg_MODE_IO_Msk                 (1UL << Reg_MODE_IO_Pos)
+#define Reg_MODE_Input                  (0UL << Reg_MODE_IO_Pos)
+#define Reg_MODE_Output                 (1UL << Reg_MODE_IO_Pos)
+
+/* Video CONTROL register definitions */
+#define Reg_CONTROL_ENABLE_Pos          0U                              /* CONTROL: Enable stream */
+#define Reg_CONTROL_ENABLE_Msk          (1UL << Reg_CONTROL_ENABLE_Pos)
+#define Reg_CONTROL_CONTINUOS_Pos       1U                              /* CONTROL: Continuous mode */
+#define Reg_CONTROL_CONTINUOS_Msk       (1UL << Reg_CONTROL_CONTINUOS_Pos)
+#define Reg_CONTROL_BUF_FLUSH_Pos       2U                              /* CONTROL: Flush buffer (self-clearing) */
+#define Reg_CONTROL_BUF_FLUSH_Msk       (1UL << Reg_CONTROL_BUF_FLUSH_Pos)
+
+/* Video STATUS register definitions */
+#define Reg_STATUS_ACTIVE_Pos           0U                              /* STATUS: Stream active */
+#define Reg_STATUS_ACTIVE_Msk           (1UL << Reg_STATUS_ACTIVE_Pos)
+#define Reg_STATUS_BUF_EMPTY_Pos        1U                              /* STATUS: Buffer empty */
+#define Reg_STATUS_BUF_EMPTY_Msk        (1UL << Reg_STATUS_BUF_EMPTY_Pos)
+#define Reg_STATUS_BUF_FULL_Pos         2U                              /* STATUS: Buffer full */
+#define Reg_STATUS_BUF_FULL_Msk         (1UL << Reg_STATUS_BUF_FULL_Pos)
+#define Reg_STATUS_OVERFLOW_Pos         3U                              /* STATUS: Overflow (cleared on read) */
+#define Reg_STATUS_OVERFLOW_Msk         (1UL << Reg_STATUS_OVERFLOW_Pos)
+#define Reg_STATUS_UNDERFLOW_Pos        4U                              /* STATUS: Underflow (cleared on read) */
+#define Reg_STATUS_UNDERFLOW_Msk        (1UL << Reg_STATUS_UNDERFLOW_Pos)
+#define Reg_STATUS_EOS_Pos              5U                              /* STATUS: End of stream (cleared on read) */
+#define Reg_STATUS_EOS_Msk              (1UL << Reg_STATUS_EOS_Pos)
+
+/* Video IRQ Status register definitions */
+#define Reg_IRQ_Status_FRAME_Pos        0U                              /* IRQ Status: frame transferred */
+#define Reg_IRQ_Status_FRAME_Msk        (1UL << Reg_IRQ_Status_FRAME_Pos)
+#define Reg_IRQ_Status_OVERFLOW_Pos     1U                              /* IRQ Status: overflow */
+#define Reg_IRQ_Status_OVERFLOW_Msk     (1UL << Reg_IRQ_Status_OVERFLOW_Pos)
+#define Reg_IRQ_Status_UNDERFLOW_Pos    2U                              /* IRQ Status: underflow */
+#define Reg_IRQ_Status_UNDERFLOW_Msk    (1UL << Reg_IRQ_Status_UNDERFLOW_Pos)
+#define Reg_IRQ_Status_EOS_Pos          3U                              /* IRQ Status: end of stream */
+#define Reg_IRQ_Status_EOS_Msk          (1UL << Reg_IRQ_Status_EOS_Pos)
+#define Reg_IRQ_Status_DESCRIPTOR_Pos   4U                              /* IRQ Status: descriptor processed */
+#define Reg_IRQ_Status_DESCRIPTOR_Msk   (1UL << Reg_IRQ_Status_DESCRIPTOR_Pos)
+#define Reg_IRQ_Status_Msk              (Reg_IRQ_Status_FRAME_Msk | Reg_IRQ_Status_OVERFLOW_Msk | Reg_IRQ_Status_UNDERFLOW_Msk | Reg_IRQ_Status_EOS_Msk | Reg_IRQ_Status_DESCRIPTOR_Msk)
+
+#endif /* __VIDEO_REGS_H */
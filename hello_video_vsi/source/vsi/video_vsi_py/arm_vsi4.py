@@ -26,6 +26,8 @@ logging.info("Verbosity level is set to " + level[verbosity])
 # Video Server configuration
 server_address = ('127.0.0.1', 6000)
 server_authkey = 'vsi_video'
+server_readahead = 4            # Input frames prepared ahead of the request (0 = read on request)
+server_writequeue = 4           # Output frames queued for the encoder (dropped when full)
 
 
 # IRQ registers
@@ -61,7 +63,7 @@ Data = bytearray()
 #  @return None
 def init():
     logging.info("Python function init() called")
-    vsi_video.init(server_address, server_authkey)
+    vsi_video.init(server_address, server_authkey, server_readahead, server_writequeue)
 
 
 ## Read interrupt request (the VSI IRQ Status Register)
@@ -71,7 +73,7 @@ def rdIRQ():
     logging.info("Python function rdIRQ() called")
 
     value = IRQ_Status
-    logging.debug("Read interrupt request: {}".format(value))
+    logging.debug("Read interrupt request: %s", value)
 
     return value
 
@@ -85,7 +87,7 @@ def wrIRQ(value):
 
     value = vsi_video.wrIRQ(IRQ_Status, value)
     IRQ_Status = value
-    logging.debug("Write interrupt request: {}".format(value))
+    logging.debug("Write interrupt request: %s", value)
 
     return value
 
@@ -100,10 +102,10 @@ def wrTimer(index, value):
 
     if   index == 0:
         Timer_Control = value
-        logging.debug("Write Timer_Control: {}".format(value))
+        logging.debug("Write Timer_Control: %s", value)
     elif index == 1:
         Timer_Interval = value
-        logging.debug("Write Timer_Interval: {}".format(value))
+        logging.debug("Write Timer_Interval: %s", value)
 
     return value
 
@@ -128,7 +130,7 @@ def wrDMA(index, value):
 
     if   index == 0:
         DMA_Control = value
-        logging.debug("Write DMA_Control: {}".format(value))
+        logging.debug("Write DMA_Control: %s", value)
 
     return value
 
@@ -142,10 +144,14 @@ def rdDataDMA(size):
 
     Data = vsi_video.rdDataDMA(size)
 
-    n = min(len(Data), size)
-    data = bytearray(size)
-    data[0:n] = Data[0:n]
-    logging.debug("Read data ({} bytes)".format(size))
+    # Frames from shared memory are already a bytearray of the block size
+    if isinstance(Data, bytearray) and (len(Data) == size):
+        data = Data
+    else:
+        n = min(len(Data), size)
+        data = bytearray(size)
+        data[0:n] = Data[0:n]
+    logging.debug("Read data (%s bytes)", size)
 
     return data
 
@@ -159,7 +165,7 @@ def wrDataDMA(data, size):
     logging.info("Python function wrDataDMA() called")
 
     Data = data
-    logging.debug("Write data ({} bytes)".format(size))
+    logging.debug("Write data (%s bytes)", size)
 
     vsi_video.wrDataDMA(data, size)
 
@@ -177,7 +183,7 @@ def rdRegs(index):
         Regs[index] = vsi_video.rdRegs(index)
 
     value = Regs[index]
-    logging.debug("Read user register at index {}: {}".format(index, value))
+    logging.debug("Read user register at index %s: %s", index, value)
 
     return value
 
@@ -194,7 +200,7 @@ def wrRegs(index, value):
         value = vsi_video.wrRegs(index, value)
 
     Regs[index] = value
-    logging.debug("Write user register at index {}: {}".format(index, value))
+    logging.debug("Write user register at index %s: %s", index, value)
 
     return value
 
@@ -0,0 +1,155 @@
+# Copyright (c) 2026 Arm Limited. All rights reserved.
+
+# Generated by vsi_regmap.py from video_regs.json, do not edit
+
+# Video Peripheral registers (VSI user registers)
+
+REG_NUM                   = 15          # Number of user registers
+REG_IDX_MAX               = 14          # Maximum user register index
+
+MODE_Idx                  = 0           # Mode: 0=Input, 1=Output
+CONTROL_Idx               = 1           # Control: enable, continuos, flush
+STATUS_Idx                = 2           # Status: active, buf_empty, buf_full, overflow, underflow, eos, read-only
+FILENAME_LEN_Idx          = 3           # Filename length
+FILENAME_CHAR_Idx         = 4           # Filename character
+FILENAME_VALID_Idx        = 5           # Filename valid flag, read-only
+FRAME_WIDTH_Idx           = 6           # Requested frame width
+FRAME_HEIGHT_Idx          = 7           # Requested frame height
+COLOR_FORMAT_Idx          = 8           # Color format
+FRAME_RATE_Idx            = 9           # Frame rate
+FRAME_INDEX_Idx           = 10          # Frame index (write advances)
+FRAME_COUNT_Idx           = 11          # Frame count, read-only
+FRAME_COUNT_MAX_Idx       = 12          # Frame count maximum
+DESCRIPTOR_Idx            = 13          # Descriptor size of next DMA block (0 when processed)
+FRAME_RATE_DEN_Idx        = 14          # Frame rate denominator (FRAME_RATE/FRAME_RATE_DEN, 0=1)
+
+# MODE register definitions
+MODE_IO_Pos               = 0
+MODE_IO_Msk               = 1<<0
+MODE_Input                = 0<<0
+MODE_Output               = 1<<0
+
+# CONTROL register definitions
+CONTROL_ENABLE_Pos        = 0
+CONTROL_ENABLE_Msk        = 1<<0
+CONTROL_CONTINUOS_Pos     = 1
+CONTROL_CONTINUOS_Msk     = 1<<1
+CONTROL_BUF_FLUSH_Pos     = 2
+CONTROL_BUF_FLUSH_Msk     = 1<<2
+
+# STATUS register definitions
+STATUS_ACTIVE_Pos         = 0
+STATUS_ACTIVE_Msk         = 1<<0
+STATUS_BUF_EMPTY_Pos      = 1
+STATUS_BUF_EMPTY_Msk      = 1<<1
+STATUS_BUF_FULL_Pos       = 2
+STATUS_BUF_FULL_Msk       = 1<<2
+STATUS_OVERFLOW_Pos       = 3
+STATUS_OVERFLOW_Msk       = 1<<3
+STATUS_UNDERFLOW_Pos      = 4
+STATUS_UNDERFLOW_Msk      = 1<<4
+STATUS_EOS_Pos            = 5
+STATUS_EOS_Msk            = 1<<5
+
+# IRQ Status register definitions
+IRQ_Status_FRAME_Msk      = 1<<0        # IRQ Status: frame transferred
+IRQ_Status_OVERFLOW_Msk   = 1<<1        # IRQ Status: overflow
+IRQ_Status_UNDERFLOW_Msk  = 1<<2        # IRQ Status: underflow
+IRQ_Status_EOS_Msk        = 1<<3        # IRQ Status: end of stream
+IRQ_Status_DESCRIPTOR_Msk = 1<<4        # IRQ Status: descriptor processed
+IRQ_Status_Msk            = IRQ_Status_FRAME_Msk | IRQ_Status_OVERFLOW_Msk | IRQ_Status_UNDERFLOW_Msk | IRQ_Status_EOS_Msk | IRQ_Status_DESCRIPTOR_Msk
+
+## Registers: (index, name, access)
+REGISTERS = (
+    (0, 'MODE', 'rw'),
+    (1, 'CONTROL', 'rw'),
+    (2, 'STATUS', 'ro'),
+    (3, 'FILENAME_LEN', 'rw'),
+    (4, 'FILENAME_CHAR', 'rw'),
+    (5, 'FILENAME_VALID', 'ro'),
+    (6, 'FRAME_WIDTH', 'rw'),
+    (7, 'FRAME_HEIGHT', 'rw'),
+    (8, 'COLOR_FORMAT', 'rw'),
+    (9, 'FRAME_RATE', 'rw'),
+    (10, 'FRAME_INDEX', 'rw'),
+    (11, 'FRAME_COUNT', 'ro'),
+    (12, 'FRAME_COUNT_MAX', 'rw'),
+    (13, 'DESCRIPTOR', 'rw'),
+    (14, 'FRAME_RATE_DEN', 'rw'),
+)
+
+__all__ = (
+    'REG_NUM',
+    'REG_IDX_MAX',
+    'MODE_Idx',
+    'CONTROL_Idx',
+    'STATUS_Idx',
+    'FILENAME_LEN_Idx',
+    'FILENAME_CHAR_Idx',
+    'FILENAME_VALID_Idx',
+    'FRAME_WIDTH_Idx',
+    'FRAME_HEIGHT_Idx',
+    'COLOR_FORMAT_Idx',
+    'FRAME_RATE_Idx',
+    'FRAME_INDEX_Idx',
+    'FRAME_COUNT_Idx',
+    'FRAME_COUNT_MAX_Idx',
+    'DESCRIPTOR_Idx',
+    'FRAME_RATE_DEN_Idx',
+    'MODE_IO_Pos',
+    'MODE_IO_Msk',
+    'MODE_Input',
+    'MODE_Output',
+    'CONTROL_ENABLE_Pos',
+    'CONTROL_ENABLE_Msk',
+    'CONTROL_CONTINUOS_Pos',
+    'CONTROL_CONTINUOS_Msk',
+    'CONTROL_BUF_FLUSH_Pos',
+    'CONTROL_BUF_FLUSH_Msk',
+    'STATUS_ACTIVE_Pos',
+    'STATUS_ACTIVE_Msk',
+    'STATUS_BUF_EMPTY_Pos',
+    'STATUS_BUF_EMPTY_Msk',
+    'STATUS_BUF_FULL_Pos',
+    'STATUS_BUF_FULL_Msk',
+    'STATUS_OVERFLOW_Pos',
+    'STATUS_OVERFLOW_Msk',
+    'STATUS_UNDERFLOW_Pos',
+    'STATUS_UNDERFLOW_Msk',
+    'STATUS_EOS_Pos',
+    'STATUS_EOS_Msk',
+    'IRQ_Status_FRAME_Msk',
+    'IRQ_Status_OVERFLOW_Msk',
+    'IRQ_Status_UNDERFLOW_Msk',
+    'IRQ_Status_EOS_Msk',
+    'IRQ_Status_DESCRIPTOR_Msk',
+    'IRQ_Status_Msk',
+)
+
+
+## Build register dispatch tables for a model script
+#
+#  Register values are held in the model namespace (module globals) under the
+#  register name. Model functions rd<NAME>() and wr<NAME>(value) replace the
+#  default access; a write function stores the register and returns the value
+#  reported as written. Writes to read-only registers without write function
+#  leave the register unchanged.
+#  @param model model namespace (dict)
+#  @return (rd, wr) tuples of REG_NUM access functions indexed by register index
+def dispatch(model):
+    def reader(name):
+        return lambda: model[name]
+    def writer(name):
+        def write(value):
+            model[name] = value
+            return value
+        return write
+    def ignore(name):
+        return lambda value: model[name]
+    rd = []
+    wr = []
+    for index, name, access in REGISTERS:
+        model.setdefault(name, 0)
+        rd.append(model.get('rd' + name) or reader(name))
+        wr.append(model.get('wr' + name) or (ignore(name) if access == 'ro' else writer(name)))
+    return tuple(rd), tuple(wr)
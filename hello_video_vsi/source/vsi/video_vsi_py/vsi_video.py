@@ -24,6 +24,8 @@ try:
     from multiprocessing.connection import Client, Connection
     from os import path, getcwd
     from os import name as os_name
+    import video_regs
+    from video_regs import *
 except ImportError as err:
     print(f"VSI:Video:ImportError: {err}")
     raise
@@ -31,6 +33,12 @@ except Exception as e:
     print(f"VSI:Video:Exception: {type(e).__name__}")
     raise
 
+# Shared memory frame transport (frames are sent over the connection when not available)
+try:
+    from multiprocessing import shared_memory
+except ImportError:
+    shared_memory = None
+
 
 class VideoClient:
     def __init__(self):
@@ -42,6 +50,9 @@ class VideoClient:
         self.FRAME_READ       = 5
         self.FRAME_WRITE      = 6
         self.CLOSE_SERVER     = 7
+        self.SHM_OPEN         = 8
+        self.FRAME_READ_SHM   = 9
+        self.FRAME_WRITE_SHM  = 10
         # Color space
         self.GRAYSCALE8       = 1
         self.RGB888           = 2
@@ -51,6 +62,14 @@ class VideoClient:
         self.NV21             = 6
         # Variables
         self.conn = None
+        # Shared memory frame ring (created by the server)
+        self.shm         = None
+        self.shm_slots   = 0
+        self.shm_size    = 0
+        self.shm_slot    = 0
+        self.shm_pending = 0
+        # Output frames dropped by the server encoder (queue full)
+        self.dropped     = 0
 
     def connectToServer(self, address, authkey):
         for _ in range(50):
@@ -64,52 +83,140 @@ class VideoClient:
                 self.conn = None
             time.sleep(0.01)
 
+    # Receive write acknowledgement (False when the server dropped the frame)
+    def recvWrite(self):
+        if not self.conn.recv():
+            self.dropped += 1
+
+    # Wait for the server to release the written shared memory slots
+    def waitWrites(self):
+        while self.shm_pending != 0:
+            self.recvWrite()
+            self.shm_pending -= 1
+
+    # Number of output frames dropped by the server since the last call
+    def framesDropped(self):
+        dropped = self.dropped
+        self.dropped = 0
+
+        return dropped
+
+    def openSharedMemory(self):
+        self.closeSharedMemory()
+        if shared_memory is None:
+            return
+
+        self.conn.send([self.SHM_OPEN])
+        shm_info = self.conn.recv()
+        if shm_info is None:
+            return
+
+        name, self.shm_slots, self.shm_size = shm_info
+        try:
+            self.shm = shared_memory.SharedMemory(name=name)
+        except Exception as e:
+            logging.warning(f"Shared memory not available: {e}")
+            self.shm = None
+            return
+        # Segment is owned by the server, do not let this process unlink it at exit
+        try:
+            from multiprocessing import resource_tracker
+            resource_tracker.unregister(self.shm._name, 'shared_memory')
+        except Exception:
+            pass
+        self.shm_slot = 0
+        logging.info("Frames transferred in shared memory %s", name)
+
+    def closeSharedMemory(self):
+        self.waitWrites()
+        if self.shm is not None:
+            self.shm.close()
+            self.shm = None
+
     def setFilename(self, filename, mode):
+        self.waitWrites()
         self.conn.send([self.SET_FILENAME, getcwd(), filename, mode])
         filename_valid = self.conn.recv()
 
         return filename_valid
 
-    def configureStream(self, frame_width, frame_height, color_format, frame_rate):
-        self.conn.send([self.STREAM_CONFIGURE, frame_width, frame_height, color_format, frame_rate])
+    def configureStream(self, frame_width, frame_height, color_format, frame_rate, frame_rate_den=1):
+        self.waitWrites()
+        self.conn.send([self.STREAM_CONFIGURE, frame_width, frame_height, color_format, frame_rate, frame_rate_den])
         configuration_valid = self.conn.recv()
 
         return configuration_valid
 
     def enableStream(self, mode):
+        self.waitWrites()
         self.conn.send([self.STREAM_ENABLE, mode])
         stream_active = self.conn.recv()
+        if stream_active:
+            self.openSharedMemory()
+        self.dropped = 0
 
         return stream_active
 
     def disableStream(self):
+        self.closeSharedMemory()
         self.conn.send([self.STREAM_DISABLE])
         stream_active = self.conn.recv()
 
         return stream_active
 
-    def readFrame(self):
-        self.conn.send([self.FRAME_READ])
-        data = self.conn.recv_bytes()
-        eos  = self.conn.recv()
+    # Read frame, with shared memory the data is returned padded to size bytes
+    def readFrame(self, size=None):
+        if self.shm is None:
+            self.conn.send([self.FRAME_READ])
+            data = self.conn.recv_bytes()
+            eos  = self.conn.recv()
+            return data, eos
+
+        self.waitWrites()
+        self.conn.send([self.FRAME_READ_SHM])
+        slot, n, eos = self.conn.recv()
+        if size is None:
+            size = n
+        offset = slot * self.shm_size
+        if n == size:
+            data = bytearray(self.shm.buf[offset:offset + n])
+        else:
+            n = min(n, size)
+            data = bytearray(size)
+            data[0:n] = self.shm.buf[offset:offset + n]
 
         return data, eos
 
+    # Write frame, with shared memory the slot is reused once the server has queued it
     def writeFrame(self, data):
-        self.conn.send([self.FRAME_WRITE])
-        self.conn.send_bytes(data)
+        if (self.shm is None) or (len(data) > self.shm_size):
+            self.waitWrites()
+            self.conn.send([self.FRAME_WRITE])
+            self.conn.send_bytes(data)
+            self.recvWrite()
+            return
+
+        # Collect acknowledgements already received, wait only when all slots are in use
+        while (self.shm_pending != 0) and ((self.shm_pending == self.shm_slots) or self.conn.poll()):
+            self.recvWrite()
+            self.shm_pending -= 1
+        offset = self.shm_slot * self.shm_size
+        self.shm.buf[offset:offset + len(data)] = data
+        self.conn.send([self.FRAME_WRITE_SHM, self.shm_slot, len(data)])
+        self.shm_pending += 1
+        self.shm_slot = (self.shm_slot + 1) % self.shm_slots
 
     def closeServer(self):
         try:
             if isinstance(self.conn, Connection):
+                self.closeSharedMemory()
                 self.conn.send([self.CLOSE_SERVER])
                 self.conn.close()
         except Exception as e:
             logging.error(f'Exception occurred on cleanup: {e}')
 
 
-# User registers
-REG_IDX_MAX               = 12  # Maximum user register index used in VSI
+# User registers (register map and IRQ Status bits generated from video_regs.json, see vsi_regmap.py)
 MODE                      = 0   # Regs[0]  // Mode: 0=Input, 1=Output
 CONTROL                   = 0   # Regs[1]  // Control: enable, flush
 STATUS                    = 0   # Regs[2]  // Status: active, buf_empty, buf_full, overflow, underflow, eos
@@ -123,35 +230,32 @@ FRAME_RATE                = 0   # Regs[9]  // Frame rate
 FRAME_INDEX               = 0   # Regs[10] // Frame index
 FRAME_COUNT               = 0   # Regs[11] // Frame count
 FRAME_COUNT_MAX           = 0   # Regs[12] // Frame count maximum
-
-# MODE register definitions
-MODE_IO_Msk               = 1<<0
-MODE_Input                = 0<<0
-MODE_Output               = 1<<0
-
-# CONTROL register definitions
-CONTROL_ENABLE_Msk        = 1<<0
-CONTROL_CONTINUOS_Msk     = 1<<1
-CONTROL_BUF_FLUSH_Msk     = 1<<2
-
-# STATUS register definitions
-STATUS_ACTIVE_Msk         = 1<<0
-STATUS_BUF_EMPTY_Msk      = 1<<1
-STATUS_BUF_FULL_Msk       = 1<<2
-STATUS_OVERFLOW_Msk       = 1<<3
-STATUS_UNDERFLOW_Msk      = 1<<4
-STATUS_EOS_Msk            = 1<<5
-
-# IRQ Status register definitions
-IRQ_Status_FRAME_Msk      = 1<<0
-IRQ_Status_OVERFLOW_Msk   = 1<<1
-IRQ_Status_UNDERFLOW_Msk  = 1<<2
-IRQ_Status_EOS_Msk        = 1<<3
+DESCRIPTOR                = 0   # Regs[13] // Descriptor size of next DMA block
+FRAME_RATE_DEN            = 0   # Regs[14] // Frame rate denominator (0=1)
+
+# Stream descriptor record tags (record: header (tag << 16) | size, payload padded to 4 bytes)
+DESC_END                  = 0   # End of descriptor
+DESC_FILENAME             = 1   # Filename (characters)
+DESC_FRAME_WIDTH          = 2   # Frame width (32-bit)
+DESC_FRAME_HEIGHT         = 3   # Frame height (32-bit)
+DESC_COLOR_FORMAT         = 4   # Color format (32-bit)
+DESC_FRAME_RATE           = 5   # Frame rate (32-bit)
+DESC_FRAME_RATE_DEN       = 6   # Frame rate denominator (32-bit)
+
+# Descriptor parameter records: tag -> user register index
+DescRegs = {
+    DESC_FRAME_WIDTH:    FRAME_WIDTH_Idx,
+    DESC_FRAME_HEIGHT:   FRAME_HEIGHT_Idx,
+    DESC_COLOR_FORMAT:   COLOR_FORMAT_Idx,
+    DESC_FRAME_RATE:     FRAME_RATE_Idx,
+    DESC_FRAME_RATE_DEN: FRAME_RATE_DEN_Idx,
+}
 
 # Variables
 Video                     = VideoClient()
 Filename                  = ""
 FilenameIdx               = 0
+DescriptorDone            = False
 
 
 # Close VSI Video Server on exit
@@ -160,7 +264,9 @@ def cleanup():
 
 
 # Client connection to VSI Video Server
-def init(address, authkey):
+#  readahead:  input frames prepared ahead by the server (None = server default)
+#  writequeue: output frames queued for the server encoder (None = server default)
+def init(address, authkey, readahead=None, writequeue=None):
     global FILENAME_VALID
 
     base_dir = path.dirname(__file__)
@@ -177,6 +283,10 @@ def init(address, authkey):
               f"--ip {address[0]} "\
               f"--port {address[1]} "\
               f"--authkey {authkey}"
+        if readahead is not None:
+            cmd += f" --readahead {readahead}"
+        if writequeue is not None:
+            cmd += f" --writequeue {writequeue}"
         subprocess.Popen(cmd, shell=True)
         # Connect to Video Server
         Video.connectToServer(address, authkey)
@@ -216,6 +326,11 @@ def wrIRQ(IRQ_Status, value):
 #  @param IRQ_Status IRQ status register to update
 #  @return IRQ_Status return updated register
 def timerEvent(IRQ_Status):
+    global DescriptorDone
+
+    if DescriptorDone:
+        DescriptorDone = False
+        return IRQ_Status | IRQ_Status_DESCRIPTOR_Msk
 
     IRQ_Status |= IRQ_Status_FRAME_Msk
 
@@ -243,7 +358,7 @@ def rdDataDMA(size):
     if (STATUS & STATUS_ACTIVE_Msk) != 0:
 
         if Video.conn != None:
-            data, eos = Video.readFrame()
+            data, eos = Video.readFrame(size)
             if eos:
                 STATUS |= STATUS_EOS_Msk
             if FRAME_COUNT < FRAME_COUNT_MAX:
@@ -266,12 +381,20 @@ def rdDataDMA(size):
 #  @param data data to write (bytearray)
 #  @param size size of data to write (in bytes, multiple of 4)
 def wrDataDMA(data, size):
-    global STATUS, FRAME_COUNT
+    global STATUS, FRAME_COUNT, DESCRIPTOR, DescriptorDone
+
+    if DESCRIPTOR != 0:
+        processDescriptor(data[0:min(DESCRIPTOR, size)])
+        DESCRIPTOR = 0
+        DescriptorDone = True
+        return
 
     if (STATUS & STATUS_ACTIVE_Msk) != 0:
 
         if Video.conn != None:
             Video.writeFrame(data)
+            if Video.framesDropped() != 0:
+                STATUS |= STATUS_OVERFLOW_Msk
             if FRAME_COUNT > 0:
                 FRAME_COUNT -= 1
             else:
@@ -281,8 +404,55 @@ def wrDataDMA(data, size):
             STATUS &= ~STATUS_BUF_FULL_Msk
 
 
+## Set filename and check it on the Server side
+#  @param filename filename (string)
+def setFilename(filename):
+    global FILENAME_VALID
+
+    logging.info("Check if file exists on Server side and set VALID flag")
+    logging.debug("Filename: %s", filename)
+
+    if Video.conn != None:
+        FILENAME_VALID = Video.setFilename(filename, MODE)
+    else:
+        logging.error("Server not connected")
+
+    logging.debug("Filename VALID: %s", FILENAME_VALID)
+
+
+## Process stream descriptor (transferred by DMA M2P after writing DESCRIPTOR)
+#  Records are applied in order, parameter records like the register writes.
+#  @param data descriptor (bytearray)
+def processDescriptor(data):
+    global FILENAME_LEN, FILENAME_VALID, Filename, FilenameIdx
+
+    pos = 0
+    while pos + 4 <= len(data):
+        header = int.from_bytes(data[pos:pos + 4], 'little')
+        tag    = header >> 16
+        size   = header & 0xFFFF
+        pos   += 4
+        if tag == DESC_END or pos + size > len(data):
+            break
+        payload = data[pos:pos + size]
+        pos += (size + 3) & ~3
+
+        if tag == DESC_FILENAME:
+            Filename       = payload.decode('utf-8', errors='replace')
+            FILENAME_LEN   = len(Filename)
+            FilenameIdx    = FILENAME_LEN
+            FILENAME_VALID = 0
+            if FILENAME_LEN != 0:
+                setFilename(Filename)
+        elif tag in DescRegs and size == 4:
+            RegsWr[DescRegs[tag]](int.from_bytes(payload, 'little'))
+        else:
+            logging.warning("Descriptor record %s ignored", tag)
+
+
 ## Write CONTROL register (user register)
 #  @param value value to write (32-bit)
+#  @return value register value, BUF_FLUSH cleared (32-bit)
 def wrCONTROL(value):
     global CONTROL, STATUS
 
@@ -292,7 +462,7 @@ def wrCONTROL(value):
             logging.info("Start video stream")
             if Video.conn != None:
                 logging.info("Configure video stream")
-                configuration_valid = Video.configureStream(FRAME_WIDTH, FRAME_HEIGHT, COLOR_FORMAT, FRAME_RATE)
+                configuration_valid = Video.configureStream(FRAME_WIDTH, FRAME_HEIGHT, COLOR_FORMAT, FRAME_RATE, max(FRAME_RATE_DEN, 1))
                 if configuration_valid:
                     logging.info("Enable video stream")
                     server_active = Video.enableStream(MODE)
@@ -319,6 +489,8 @@ def wrCONTROL(value):
 
     CONTROL = value
 
+    return value
+
 
 ## Read STATUS register (user register)
 # @return status current STATUS User register (32-bit)
@@ -333,6 +505,7 @@ def rdSTATUS():
 
 ## Write FILENAME_LEN register (user register)
 #  @param value value to write (32-bit)
+#  @return value value written (32-bit)
 def wrFILENAME_LEN(value):
     global STATUS, FILENAME_LEN, FILENAME_VALID, Filename, FilenameIdx
 
@@ -342,28 +515,25 @@ def wrFILENAME_LEN(value):
     FILENAME_VALID = 0
     FILENAME_LEN = value
 
+    return value
+
 
 ## Write FILENAME_CHAR register (user register)
 #  @param value value to write (32-bit)
+#  @return value value written (32-bit)
 def wrFILENAME_CHAR(value):
-    global FILENAME_VALID, Filename, FilenameIdx
+    global Filename, FilenameIdx
 
     if FilenameIdx < FILENAME_LEN:
-        logging.info(f"Append {value} to filename")
-        Filename += f"{value}"
+        logging.info("Append %s to filename", chr(value))
+        Filename += chr(value)
         FilenameIdx += 1
-        logging.debug(f"Received {FilenameIdx} of {FILENAME_LEN} characters")
+        logging.debug("Received %s of %s characters", FilenameIdx, FILENAME_LEN)
 
     if FilenameIdx == FILENAME_LEN:
-        logging.info("Check if file exists on Server side and set VALID flag")
-        logging.debug(f"Filename: {Filename}")
-
-        if Video.conn != None:
-            FILENAME_VALID = Video.setFilename(Filename, MODE)
-        else:
-            logging.error("Server not connected")
+        setFilename(Filename)
 
-        logging.debug(f"Filename VALID: {FILENAME_VALID}")
+    return value
 
 
 ## Write FRAME_INDEX register (user register)
@@ -394,77 +564,56 @@ def wrFRAME_INDEX(value):
     return FRAME_INDEX
 
 
+## Write FRAME_WIDTH register (user register), 0 keeps the current width
+#  @param value value to write (32-bit)
+#  @return value register value (32-bit)
+def wrFRAME_WIDTH(value):
+    global FRAME_WIDTH
+
+    if value != 0:
+        FRAME_WIDTH = value
+
+    return FRAME_WIDTH
+
+
+## Write FRAME_HEIGHT register (user register), 0 keeps the current height
+#  @param value value to write (32-bit)
+#  @return value register value (32-bit)
+def wrFRAME_HEIGHT(value):
+    global FRAME_HEIGHT
+
+    if value != 0:
+        FRAME_HEIGHT = value
+
+    return FRAME_HEIGHT
+
+
+## Write FRAME_COUNT_MAX register (user register), flushes the buffer
+#  @param value value to write (32-bit)
+#  @return value value written (32-bit)
+def wrFRAME_COUNT_MAX(value):
+    global FRAME_COUNT_MAX
+
+    FRAME_COUNT_MAX = value
+    flushBuffer()
+
+    return value
+
+
 ## Read user registers (the VSI User Registers)
-#  @param index user register index (zero based)
+#  @param index user register index (zero based, up to REG_IDX_MAX)
 #  @return value value read (32-bit)
 def rdRegs(index):
-    value = 0
-
-    if   index == 0:
-        value = MODE
-    elif index == 1:
-        value = CONTROL
-    elif index == 2:
-        value = rdSTATUS()
-    elif index == 3:
-        value = FILENAME_LEN
-    elif index == 4:
-        value = FILENAME_CHAR
-    elif index == 5:
-        value = FILENAME_VALID
-    elif index == 6:
-        value = FRAME_WIDTH
-    elif index == 7:
-        value = FRAME_HEIGHT
-    elif index == 8:
-        value = COLOR_FORMAT
-    elif index == 9:
-        value = FRAME_RATE
-    elif index == 10:
-        value = FRAME_INDEX
-    elif index == 11:
-        value = FRAME_COUNT
-    elif index == 12:
-        value = FRAME_COUNT_MAX
-
-    return value
+    return RegsRd[index]()
 
 
 ## Write user registers (the VSI User Registers)
-#  @param index user register index (zero based)
+#  @param index user register index (zero based, up to REG_IDX_MAX)
 #  @param value value to write (32-bit)
 #  @return value value written (32-bit)
 def wrRegs(index, value):
-    global MODE, FRAME_WIDTH, FRAME_HEIGHT, COLOR_FORMAT, FRAME_RATE, FRAME_COUNT_MAX
-
-    if   index == 0:
-        MODE = value
-    elif index == 1:
-        wrCONTROL(value)
-    elif index == 2:
-        value = STATUS
-    elif index == 3:
-        wrFILENAME_LEN(value)
-    elif index == 4:
-        wrFILENAME_CHAR(chr(value))
-    elif index == 5:
-        value = FILENAME_VALID
-    elif index == 6:
-        if value != 0:
-            FRAME_WIDTH = value
-    elif index == 7:
-        if value != 0:
-            FRAME_HEIGHT = value
-    elif index == 8:
-        COLOR_FORMAT = value
-    elif index == 9:
-        FRAME_RATE = value
-    elif index == 10:
-        value = wrFRAME_INDEX(value)
-    elif index == 11:
-        value = FRAME_COUNT
-    elif index == 12:
-        FRAME_COUNT_MAX = value
-        flushBuffer()
+    return RegsWr[index](value)
 
-    return value
+
+# User register dispatch tables (indexed by register index)
+RegsRd, RegsWr = video_regs.dispatch(globals())
@@ -21,6 +21,9 @@ try:
     import ipaddress
     import logging
     import os
+    import queue
+    import threading
+    from fractions import Fraction
     from multiprocessing.connection import Listener
 
     import cv2
@@ -30,6 +33,12 @@ except ImportError as err:
 except Exception as e:
     print(f"VSI:Video:Server:Exception: {type(e).__name__}")
 
+# Shared memory frame transport (frames are sent over the connection when not available)
+try:
+    from multiprocessing import shared_memory
+except ImportError:
+    shared_memory = None
+
 
 ## Set verbosity level
 #verbosity = logging.DEBUG
@@ -46,6 +55,18 @@ logging.info("Verbosity level is set to " + level[verbosity])
 default_address       = ('127.0.0.1', 6000)
 default_authkey       = 'vsi_video'
 
+# Shared memory frame ring: number of frame slots
+default_shm_slots     = 4
+
+# Input read-ahead: number of prepared frames (0 = read on request)
+default_readahead     = 4
+
+# Output encoder: number of queued frames (frames are dropped when the queue is full)
+default_writequeue    = 4
+
+# Frame rate conversion: source frame timestamp tolerance (ms)
+frc_pts_tolerance     = 0.01
+
 # Supported file extensions
 video_file_extensions = ('wmv', 'avi', 'mp4')
 image_file_extensions = ('bmp', 'png', 'jpg')
@@ -57,7 +78,7 @@ MODE_Input            = 0<<0
 MODE_Output           = 1<<0
 
 class VideoServer:
-    def __init__(self, address, authkey):
+    def __init__(self, address, authkey, readahead=default_readahead, writequeue=default_writequeue):
         # Server commands
         self.SET_FILENAME     = 1
         self.STREAM_CONFIGURE = 2
@@ -66,6 +87,9 @@ class VideoServer:
         self.FRAME_READ       = 5
         self.FRAME_WRITE      = 6
         self.CLOSE_SERVER     = 7
+        self.SHM_OPEN         = 8
+        self.FRAME_READ_SHM   = 9
+        self.FRAME_WRITE_SHM  = 10
         # Color space
         self.GRAYSCALE8       = 1
         self.RGB888           = 2
@@ -80,14 +104,49 @@ class VideoServer:
         self.active           = False
         self.video            = True
         self.stream           = None
-        self.frame_ratio      = 0
-        self.frame_drop       = 0
+        # Frame rate conversion (video file input)
+        self.frc_period       = None  # Output frame period (ms)
+        self.frc_source       = None  # Source frame duration (ms)
+        self.frc_next         = None  # Output time of next frame (ms)
+        self.frc_frame        = None  # Last decoded source frame
+        self.frc_pts          = None  # Timestamp of last decoded source frame (ms)
+        self.frc_pending      = None  # Timestamp of grabbed, not decoded source frame (ms)
+        self.frc_end          = False # Source end reached
         self.frame_index      = 0
         self.eos              = False
+        # Input read-ahead
+        self.readahead        = readahead
+        self.ra_queue         = None
+        self.ra_thread        = None
+        self.ra_stop          = None
+        self.ra_hits          = 0
+        self.ra_misses        = 0
+        self.frame_pos        = 0
+        self.eos_sent         = False
+        # Output encoder
+        self.writequeue       = max(writequeue, 1)
+        self.wr_queue         = None
+        self.wr_thread        = None
+        self.wr_frames        = 0
+        self.wr_dropped       = 0
+        # Shared memory frame ring
+        self.shm              = None
+        self.shm_slots        = default_shm_slots
+        self.shm_size         = 0
+        self.shm_slot         = 0
         # Stream configuration
         self.resolution       = (None, None)
         self.color_format     = None
         self.frame_rate       = None
+        # Input frame conversion (set up per source frame size and stream configuration)
+        self.conv_key         = None
+        self.conv_crop        = None
+        self.conv_resize      = False
+        self.conv_code        = None
+        self.conv_chroma      = None
+        # Output frame conversion (set up per stream configuration)
+        self.out_shape        = None
+        self.out_code         = None
 
     # Set filename
     def _setFilename(self, base_dir, filename, mode):
@@ -126,13 +185,13 @@ class VideoServer:
         return filename_valid
 
     # Configure video stream
-    def _configureStream(self, frame_width, frame_height, color_format, frame_rate):
-        if (frame_width == 0 or frame_height == 0 or frame_rate == 0):
+    def _configureStream(self, frame_width, frame_height, color_format, frame_rate, frame_rate_den=1):
+        if (frame_width == 0 or frame_height == 0 or frame_rate == 0 or frame_rate_den == 0):
             return False
 
         self.resolution   = (frame_width, frame_height)
         self.color_format = color_format
-        self.frame_rate   = frame_rate
+        self.frame_rate   = Fraction(frame_rate, frame_rate_den)
 
         return True
 
@@ -142,8 +201,6 @@ class VideoServer:
             return
 
         self.eos = False
-        self.frame_ratio = 0
-        self.frame_drop  = 0
 
         if self.stream is not None:
             self.stream.release()
@@ -168,10 +225,7 @@ class VideoServer:
                 else:
                     self.stream = cv2.VideoCapture(self.filename)
                     self.stream.set(cv2.CAP_PROP_POS_FRAMES, self.frame_index)
-                    video_fps = self.stream.get(cv2.CAP_PROP_FPS)
-                    if video_fps > self.frame_rate:
-                        self.frame_ratio = video_fps / self.frame_rate
-                        logging.debug(f"Frame ratio: {self.frame_ratio}")
+                    self._setupRateConversion(self.stream.get(cv2.CAP_PROP_FPS))
             else:
                 if self.filename != "":
                     extension = str(self.filename).split('.')[-1].lower()
@@ -185,7 +239,7 @@ class VideoServer:
                         height = int(cap.get(cv2.CAP_PROP_FRAME_HEIGHT))
                         self.resolution = (width, height)
                         self.frame_rate = cap.get(cv2.CAP_PROP_FPS)
-                        self.stream = cv2.VideoWriter(self.filename, fourcc, self.frame_rate, self.resolution)
+                        self.stream = cv2.VideoWriter(self.filename, fourcc, float(self.frame_rate), self.resolution)
 
                         while cap.isOpened():
                             ret, frame = cap.read()
@@ -197,25 +251,201 @@ class VideoServer:
                             del frame
 
                     else:
-                        self.stream = cv2.VideoWriter(self.filename, fourcc, self.frame_rate, self.resolution)
+                        self.stream = cv2.VideoWriter(self.filename, fourcc, float(self.frame_rate), self.resolution)
 
-        self.active = True
+        self.active    = True
+        self.frame_pos = self.frame_index
+        self.eos_sent  = False
         logging.info("Stream enabled")
 
+        if (self.mode == MODE_Input) and (self.readahead > 0):
+            self._startReadAhead()
+        if self.mode == MODE_Output:
+            self._setupOutput()
+            if self.filename != "":
+                self._startEncoder()
+
     # Disable Video Server
     def _disableStream(self):
         self.active = False
+        self._stopReadAhead()
+        self._stopEncoder()
+        self._closeSharedMemory()
         if self.stream is not None:
             if self.mode == MODE_Input:
-                self.frame_index = self.stream.get(cv2.CAP_PROP_POS_FRAMES)
+                # Resume after the last delivered frame, read-ahead frames are dropped
+                self.frame_index = self.frame_pos
             self.stream.release()
             self.stream = None
         logging.info("Stream disabled")
 
-    # Resize frame to requested resolution in pixels
-    def __resizeFrame(self, frame, resolution):
-        frame_h = frame.shape[0]
-        frame_w = frame.shape[1]
+    # Source position (frames read from video file, a grabbed frame not yet used is not counted)
+    def _streamPosition(self):
+        if self.video and (self.stream is not None) and (self.filename != ""):
+            pos = self.stream.get(cv2.CAP_PROP_POS_FRAMES)
+            if self.frc_pending is not None:
+                pos -= 1
+            return pos
+        return 0
+
+    # Set up frame rate conversion from source frame rate to configured frame rate
+    def _setupRateConversion(self, source_fps):
+        self.frc_period  = Fraction(1000) / self.frame_rate
+        if source_fps > 0:
+            self.frc_source = 1000.0 / source_fps
+        else:
+            self.frc_source = float(self.frc_period)
+        self.frc_next    = None
+        self.frc_frame   = None
+        self.frc_pts     = None
+        self.frc_pending = None
+        self.frc_end     = False
+        logging.debug(f"Frame rate conversion from {source_fps} to {self.frame_rate} fps")
+
+    # Read source frame for the next output frame time (frame rate conversion)
+    #  Output frame k at time t = t0 + k * period shows the last source frame with timestamp <= t.
+    #  Source frames superseded before t are skipped with grab() without decoding, the last
+    #  frame is repeated while the next source frame is later than t.
+    #  @return frame (BGR) or None at end of stream
+    def _readSourceFrame(self):
+        while True:
+            if (self.frc_pending is None) and not self.frc_end:
+                if self.stream.grab():
+                    self.frc_pending = self.stream.get(cv2.CAP_PROP_POS_MSEC)
+                else:
+                    self.frc_end = True
+
+            if self.frc_pending is None:
+                # Source ended: repeat the last frame until its duration has elapsed
+                if (self.frc_frame is None) or \
+                   (self.frc_next + frc_pts_tolerance >= self.frc_pts + self.frc_source):
+                    return None
+                break
+
+            pts = self.frc_pending
+            if self.frc_next is None:
+                self.frc_next = Fraction(pts)
+
+            if (pts > self.frc_next + frc_pts_tolerance) and (self.frc_frame is not None):
+                # Next source frame is later: repeat the last frame
+                break
+
+            self.frc_pending = None
+            if (pts + self.frc_source <= self.frc_next + frc_pts_tolerance) and not self.frc_end:
+                # Source frame superseded before the output time: skip without decoding
+                if self.frc_frame is not None:
+                    continue
+            ret, frame = self.stream.retrieve()
+            if ret:
+                self.frc_frame = frame
+                self.frc_pts   = pts
+            break
+
+        self.frc_next += self.frc_period
+
+        return self.frc_frame
+
+    # Start read-ahead worker preparing input frames
+    def _startReadAhead(self):
+        self.ra_queue  = queue.Queue(maxsize=self.readahead)
+        self.ra_stop   = threading.Event()
+        self.ra_hits   = 0
+        self.ra_misses = 0
+        self.ra_thread = threading.Thread(target=self._readAhead, args=(self.ra_queue, self.ra_stop), daemon=True)
+        self.ra_thread.start()
+
+    # Stop read-ahead worker and report statistics
+    def _stopReadAhead(self):
+        if self.ra_thread is None:
+            return
+        self.ra_stop.set()
+        self.ra_thread.join()
+        self.ra_thread = None
+        self.ra_queue  = None
+        frames = self.ra_hits + self.ra_misses
+        if frames != 0:
+            print(f"VSI Server: Read-ahead: {frames} frames, {self.ra_hits} hits, {self.ra_misses} misses "
+                  f"({100 * self.ra_hits / frames:.1f}% hit rate)", flush=True)
+
+    # Read-ahead worker: prepares frames until end of stream (runs while decoding releases the GIL)
+    def _readAhead(self, frames, stop):
+        eos = False
+        while not (eos or stop.is_set()):
+            try:
+                frame = self._readFrameImage()
+                eos   = self.eos
+            except Exception as e:
+                logging.error(f"Error in readAhead(): {e}")
+                frame = None
+                eos   = True
+            item = (frame, eos, self._streamPosition())
+            while not stop.is_set():
+                try:
+                    frames.put(item, timeout=0.1)
+                    break
+                except queue.Full:
+                    pass
+
+    # Next prepared frame
+    #  @return (frame (numpy array) or None, end of stream)
+    def _nextFrame(self):
+        if self.ra_thread is None:
+            frame = self._readFrameImage()
+            self.frame_pos = self._streamPosition()
+            return frame, self.eos
+
+        if self.eos_sent:
+            return None, True
+
+        try:
+            frame, eos, pos = self.ra_queue.get_nowait()
+            self.ra_hits += 1
+        except queue.Empty:
+            self.ra_misses += 1
+            frame, eos, pos = self.ra_queue.get()
+
+        self.frame_pos = pos
+        self.eos_sent  = eos
+
+        return frame, eos
+
+    # Create shared memory frame ring for the configured stream
+    #  @return [name, slots, slot size] or None when frames are sent over the connection
+    def _openSharedMemory(self):
+        self._closeSharedMemory()
+
+        if (shared_memory is None) or (self.resolution[0] is None):
+            return None
+
+        # Slot holds a configured frame in any color format (up to 3 bytes per pixel)
+        size = ((self.resolution[0] * self.resolution[1] * 3) + 3) & ~3
+        try:
+            self.shm = shared_memory.SharedMemory(create=True, size=size * self.shm_slots)
+        except Exception as e:
+            logging.warning(f"Shared memory not available: {e}")
+            self.shm = None
+            return None
+
+        self.shm_size = size
+        self.shm_slot = 0
+        logging.info(f"Shared memory {self.shm.name}: {self.shm_slots} slots of {size} bytes")
+
+        return [self.shm.name, self.shm_slots, self.shm_size]
+
+    # Release shared memory frame ring
+    def _closeSharedMemory(self):
+        if self.shm is not None:
+            try:
+                self.shm.close()
+                self.shm.unlink()
+            except Exception as e:
+                logging.error(f"Error in closeSharedMemory(): {e}")
+            self.shm = None
+
+    # Set up input frame conversion: crop to the requested aspect ratio, scale and color conversion
+    def _setupConversion(self, frame_h, frame_w):
+        resolution = self.resolution
+        top, bottom, left, right = 0, frame_h, 0, frame_w
 
         # Calculate requested aspect ratio (width/height):
         crop_aspect_ratio  = resolution[0] / resolution[1]
@@ -229,95 +459,115 @@ class VideoServer:
                 # Crop top and bottom part of the image
                 top    = (frame_h - crop_h) // 2
                 bottom = top + crop_h
-                frame  = frame[top : bottom, 0 : frame_w]
             elif crop_h > frame_h:
-                # Crop left and right side of the image``
+                # Crop left and right side of the image
                 left   = (frame_w - crop_w) // 2
                 right  = left + crop_w
-                frame  = frame[0 : frame_h, left : right]
             else:
                 # Crop to the center of the image
                 left   = (frame_w - crop_w) // 2
                 right  = left + crop_w
                 top    = (frame_h - crop_h) // 2
                 bottom = top + crop_h
-                frame  = frame[top : bottom, left : right]
-            logging.debug(f"Frame cropped from ({frame_w}, {frame_h}) to ({frame.shape[1]}, {frame.shape[0]})")
+            logging.debug(f"Frame cropped from ({frame_w}, {frame_h}) to ({right - left}, {bottom - top})")
+
+        # Crop is a view into the source frame, scaling is skipped when the size already matches
+        self.conv_crop   = (slice(top, bottom), slice(left, right))
+        self.conv_resize = (right - left, bottom - top) != tuple(resolution)
+
+        # Default OpenCV color profile: BGR, NV12/NV21 are I420 with interleaved chroma
+        self.conv_code   = None
+        self.conv_chroma = None
+        if   self.color_format == self.GRAYSCALE8:
+            self.conv_code = cv2.COLOR_BGR2GRAY
+        elif self.color_format == self.RGB888:
+            self.conv_code = cv2.COLOR_BGR2RGB
+        elif self.color_format == self.BGR565:
+            self.conv_code = cv2.COLOR_BGR2BGR565
+        elif self.color_format in (self.YUV420, self.NV12, self.NV21):
+            self.conv_code = cv2.COLOR_BGR2YUV_I420
+            if   self.color_format == self.NV12:
+                self.conv_chroma = (0, 1)
+            elif self.color_format == self.NV21:
+                self.conv_chroma = (1, 0)
+
+        self.conv_key = (frame_h, frame_w, resolution, self.color_format)
+        logging.debug(f"Frame conversion from ({frame_w}, {frame_h}) to ({resolution[0]}, {resolution[1]}), color format {self.color_format}")
+
+    # Convert input frame (BGR) to requested resolution and color format
+    def _convertFrame(self, frame):
+        if self.conv_key != (frame.shape[0], frame.shape[1], self.resolution, self.color_format):
+            self._setupConversion(frame.shape[0], frame.shape[1])
+
+        frame = frame[self.conv_crop]
+
+        if self.conv_resize:
+            try:
+                frame = cv2.resize(frame, self.resolution)
+            except Exception as e:
+                logging.error(f"Error in convertFrame(): {e}")
 
-        logging.debug(f"Resize frame from ({frame.shape[1]}, {frame.shape[0]}) to ({resolution[0]}, {resolution[1]})")
-        try:
-            frame = cv2.resize(frame, resolution)
-        except Exception as e:
-            logging.error(f"Error in resizeFrame(): {e}")
+        if self.conv_code is not None:
+            try:
+                frame = cv2.cvtColor(frame, self.conv_code)
+                if self.conv_chroma is not None:
+                    frame = self.__interleaveChroma(frame, self.conv_chroma)
+            except Exception as e:
+                logging.error(f"Error in convertFrame(): {e}")
 
         return frame
 
-    # Change color space of a frame from BGR to selected profile
-    def __changeColorSpace(self, frame, color_space):
-        color_format = None
-
-        # Default OpenCV color profile: BGR
-        if self.mode == MODE_Input:
-            if   color_space == self.GRAYSCALE8:
-                color_format = cv2.COLOR_BGR2GRAY
-            elif color_space == self.RGB888:
-                color_format = cv2.COLOR_BGR2RGB
-            elif color_space == self.BGR565:
-                color_format = cv2.COLOR_BGR2BGR565
-            elif color_space == self.YUV420:
-                color_format = cv2.COLOR_BGR2YUV_I420
-            elif color_space == self.NV12:
-                frame = self.__changeColorSpace(frame, self.YUV420)
-                color_format = cv2.COLOR_YUV2RGB_NV12
-            elif color_space == self.NV21:
-                frame = self.__changeColorSpace(frame, self.YUV420)
-                color_format = cv2.COLOR_YUV2RGB_NV21
-
-        else:
-            if   color_space == self.GRAYSCALE8:
-                color_format = cv2.COLOR_GRAY2BGR
-            elif color_space == self.RGB888:
-                color_format = cv2.COLOR_RGB2BGR
-            elif color_space == self.BGR565:
-                color_format = cv2.COLOR_BGR5652BGR
-            elif color_space == self.YUV420:
-                color_format = cv2.COLOR_YUV2BGR_I420
-            elif color_space == self.NV12:
-                color_format = cv2.COLOR_YUV2BGR_I420
-            elif color_space == self.NV21:
-                color_format = cv2.COLOR_YUV2BGR_I420
-
-        if color_format != None:
-            logging.debug(f"Change color space to {color_format}")
-            try:
-                frame = cv2.cvtColor(frame, color_format)
-            except Exception as e:
-                logging.error(f"Error in changeColorSpace(): {e}")
+    # Convert I420 frame in place to semi-planar NV12/NV21 (U, V planes to interleaved chroma)
+    def __interleaveChroma(self, frame, order):
+        flat   = frame.reshape(-1)
+        luma   = self.resolution[0] * self.resolution[1]
+        plane  = luma // 4
+        chroma = flat[luma:].copy()
+        uv     = flat[luma:].reshape(-1, 2)
+        uv[:, order[0]] = chroma[:plane]
+        uv[:, order[1]] = chroma[plane:]
 
         return frame
 
-    # Read frame from source
-    def _readFrame(self):
-        frame = bytearray()
+    # Set up output frame conversion: frame layout of the configured color format and conversion to BGR
+    def _setupOutput(self):
+        width, height = int(self.resolution[0]), int(self.resolution[1])
+
+        if   self.color_format == self.GRAYSCALE8:
+            self.out_shape = (height, width)
+            self.out_code  = cv2.COLOR_GRAY2BGR
+        elif self.color_format == self.RGB888:
+            self.out_shape = (height, width, 3)
+            self.out_code  = cv2.COLOR_RGB2BGR
+        elif self.color_format == self.BGR565:
+            self.out_shape = (height, width, 2)
+            self.out_code  = cv2.COLOR_BGR5652BGR
+        elif self.color_format == self.YUV420:
+            self.out_shape = (height * 3 // 2, width)
+            self.out_code  = cv2.COLOR_YUV2BGR_I420
+        elif self.color_format == self.NV12:
+            self.out_shape = (height * 3 // 2, width)
+            self.out_code  = cv2.COLOR_YUV2BGR_NV12
+        elif self.color_format == self.NV21:
+            self.out_shape = (height * 3 // 2, width)
+            self.out_code  = cv2.COLOR_YUV2BGR_NV21
+        else:
+            logging.error(f"Unsupported output color format: {self.color_format}")
+            self.out_shape = None
+            self.out_code  = None
 
+    # Read frame from source
+    #  @return frame (numpy array) or None
+    def _readFrameImage(self):
         if not self.active:
-            return frame
+            return None
 
         if self.eos:
-            return frame
+            return None
 
         if self.video:
-            if self.frame_ratio > 1:
-                _, tmp_frame = self.stream.read()
-                self.frame_drop += (self.frame_ratio - 1)
-                if self.frame_drop > 1:
-                    logging.debug(f"Frames to drop: {self.frame_drop}")
-                    drop = int(self.frame_drop // 1)
-                    for i in range(drop):
-                        _, _ = self.stream.read()
-                    logging.debug(f"Frames dropped: {drop}")
-                    self.frame_drop -= drop
-                    logging.debug(f"Frames left to drop: {self.frame_drop}")
+            if self.filename != "":
+                tmp_frame = self._readSourceFrame()
             else:
                 _, tmp_frame = self.stream.read()
             if tmp_frame is None:
@@ -329,33 +579,117 @@ class VideoServer:
             logging.debug("End of stream.")
 
         if tmp_frame is not None:
-            tmp_frame = self.__resizeFrame(tmp_frame, self.resolution)
-            tmp_frame = self.__changeColorSpace(tmp_frame, self.color_format)
+            tmp_frame = self._convertFrame(tmp_frame)
+
+        return tmp_frame
+
+    # Read frame from source (frame data)
+    #  @return (frame (bytearray), end of stream)
+    def _readFrame(self):
+        frame = bytearray()
+
+        tmp_frame, eos = self._nextFrame()
+        if tmp_frame is not None:
             frame = bytearray(tmp_frame.tobytes())
 
-        return frame
+        return frame, eos
 
-    # Write frame to destination
-    def _writeFrame(self, frame):
-        if not self.active:
+    # Read frame from source into the next shared memory slot
+    #  @return (slot, frame size in bytes, end of stream)
+    def _readFrameShm(self):
+        slot = self.shm_slot
+        size = 0
+
+        tmp_frame, eos = self._nextFrame()
+        if tmp_frame is not None:
+            size = tmp_frame.nbytes
+            if size <= self.shm_size:
+                dst = np.frombuffer(self.shm.buf, dtype=np.uint8, count=size, offset=slot * self.shm_size)
+                dst[:] = tmp_frame.reshape(-1)
+                del dst
+            else:
+                logging.error(f"Frame size {size} exceeds shared memory slot size {self.shm_size}")
+                size = 0
+
+        self.shm_slot = (slot + 1) % self.shm_slots
+
+        return slot, size, eos
+
+    # Start output encoder worker
+    def _startEncoder(self):
+        self.wr_queue   = queue.Queue(maxsize=self.writequeue)
+        self.wr_frames  = 0
+        self.wr_dropped = 0
+        self.wr_thread  = threading.Thread(target=self._encodeFrames, args=(self.wr_queue,), daemon=True)
+        self.wr_thread.start()
+
+    # Stop output encoder worker after the queued frames are written and report statistics
+    def _stopEncoder(self):
+        if self.wr_thread is None:
             return
+        self.wr_queue.put(None)
+        self.wr_thread.join()
+        self.wr_thread = None
+        self.wr_queue  = None
+        frames = self.wr_frames + self.wr_dropped
+        if frames != 0:
+            print(f"VSI Server: Encoder: {frames} frames, {self.wr_frames} written, {self.wr_dropped} dropped",
+                  flush=True)
+
+    # Output encoder worker: converts and writes queued frames to the output file until stopped (None)
+    def _encodeFrames(self, frames):
+        while True:
+            frame = frames.get()
+            if frame is None:
+                break
+            try:
+                self._encodeFrame(frame)
+            except Exception as e:
+                logging.error(f"Error in encodeFrame(): {e}")
 
+    # Convert frame to BGR and write it to the output file
+    def _encodeFrame(self, frame):
+        bgr_frame = cv2.cvtColor(frame, self.out_code)
+
+        if self.video:
+            self.stream.write(bgr_frame)
+            self.frame_index += 1
+        else:
+            cv2.imwrite(self.filename, bgr_frame)
+
+    # Convert frame to BGR and show it on the display (HighGUI is driven from the server main loop only)
+    def _showFrame(self, frame):
         try:
-            decoded_frame = np.frombuffer(frame, dtype=np.uint8)
-            decoded_frame = decoded_frame.reshape((self.resolution[0], self.resolution[1], 3))
-            bgr_frame = self.__changeColorSpace(decoded_frame, self.RGB888)
+            cv2.imshow(self.filename, cv2.cvtColor(frame, self.out_code))
+            cv2.waitKey(1)
+        except Exception as e:
+            logging.error(f"Error in showFrame(): {e}")
 
-            if self.filename == "":
-                cv2.imshow(self.filename, bgr_frame)
-                cv2.waitKey(10)
-            else:
-                if self.video:
-                    self.stream.write(np.uint8(bgr_frame))
-                    self.frame_index += 1
-                else:
-                    cv2.imwrite(self.filename, bgr_frame)
-        except Exception:
-            pass
+    # Write frame to destination: display frames are shown right away, file frames are copied
+    # and queued for the output encoder
+    #  @return True when written or queued, False when dropped (encoder queue full or invalid frame)
+    def _writeFrame(self, frame):
+        if (not self.active) or (self.out_shape is None):
+            return False
+
+        size = int(np.prod(self.out_shape))
+        if len(frame) < size:
+            logging.error(f"Frame size {len(frame)} is smaller than configured frame size {size}")
+            self.wr_dropped += 1
+            return False
+
+        if self.wr_queue is None:
+            self._showFrame(np.frombuffer(frame, dtype=np.uint8, count=size).reshape(self.out_shape))
+            return True
+
+        try:
+            self.wr_queue.put_nowait(np.frombuffer(frame, dtype=np.uint8, count=size).reshape(self.out_shape).copy())
+        except queue.Full:
+            self.wr_dropped += 1
+            return False
+
+        self.wr_frames += 1
+        return True
 
     # Run Video Server
     def run(self):
@@ -384,7 +718,7 @@ class VideoServer:
 
             elif cmd == self.STREAM_CONFIGURE:
                 logging.info("Stream configure called")
-                configuration_valid = self._configureStream(payload[0], payload[1], payload[2], payload[3])
+                configuration_valid = self._configureStream(*payload)
                 conn.send(configuration_valid)
 
             elif cmd == self.STREAM_ENABLE:
@@ -399,14 +733,37 @@ class VideoServer:
 
             elif cmd == self.FRAME_READ:
                 logging.info("Read frame called")
-                frame = self._readFrame()
+                frame, eos = self._readFrame()
                 conn.send_bytes(frame)
-                conn.send(self.eos)
+                conn.send(eos)
 
             elif cmd == self.FRAME_WRITE:
                 logging.info("Write frame called")
                 frame = conn.recv_bytes()
-                self._writeFrame(frame)
+                conn.send(self._writeFrame(frame))
+
+            elif cmd == self.SHM_OPEN:
+                logging.info("Open shared memory called")
+                conn.send(self._openSharedMemory())
+
+            elif cmd == self.FRAME_READ_SHM:
+                logging.info("Read frame (shared memory) called")
+                if self.shm is not None:
+                    slot, size, eos = self._readFrameShm()
+                else:
+                    slot, size, eos = 0, 0, self.eos
+                conn.send([slot, size, eos])
+
+            elif cmd == self.FRAME_WRITE_SHM:
+                logging.info("Write frame (shared memory) called")
+                slot, size = payload[0], payload[1]
+                queued = False
+                if (self.shm is not None) and (size <= self.shm_size):
+                    offset = slot * self.shm_size
+                    frame  = self.shm.buf[offset:offset + size]
+                    queued = self._writeFrame(frame)
+                    frame.release()
+                conn.send(queued)
 
             elif cmd == self.CLOSE_SERVER:
                 logging.info("Close server connection")
@@ -446,12 +803,18 @@ def parse_arguments():
     parser_optional.add_argument("--authkey", dest="authkey",  metavar="<Auth Key>",
                                  help=f"Authorization key (default: {default_authkey})",
                                  type=str, default=default_authkey)
+    parser_optional.add_argument("--readahead", dest="readahead",  metavar="<Frames>",
+                                 help=f"Input frames prepared ahead, 0 to read on request (default: {default_readahead})",
+                                 type=int, default=default_readahead)
+    parser_optional.add_argument("--writequeue", dest="writequeue",  metavar="<Frames>",
+                                 help=f"Output frames queued for the encoder (default: {default_writequeue})",
+                                 type=int, default=default_writequeue)
 
     return parser.parse_args()
 
 if __name__ == '__main__':
     args = parse_arguments()
-    Server = VideoServer((args.ip, args.port), args.authkey)
+    Server = VideoServer((args.ip, args.port), args.authkey, args.readahead, args.writequeue)
     try:
         Server.run()
     except KeyboardInterrupt:
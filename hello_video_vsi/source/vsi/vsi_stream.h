@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Virtual Streaming Interface (VSI) stream core
+ *
+ * Binds a stream handle to any of the 8 VSI peripherals and provides the
+ * interrupt dispatch, DMA/Timer programming and block ring bookkeeping
+ * shared by the peripheral drivers.
+ */
+
+#ifndef VSI_STREAM_H
+#define VSI_STREAM_H
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#include "arm_vsi.h"
+
+/* Number of VSI peripherals */
+#define VSI_STREAM_INSTANCES            (8U)
+
+/* Stream direction */
+#define VSI_STREAM_INPUT                (0U)        ///< Peripheral to memory
+#define VSI_STREAM_OUTPUT               (1U)        ///< Memory to peripheral
+
+/* Stream timer mode */
+#define VSI_STREAM_SINGLE               (0U)        ///< Single block transfer
+#define VSI_STREAM_PERIODIC             (1U)        ///< Periodic block transfer
+
+/* IRQ Status bit signaling a transferred block (same position for all peripherals) */
+#define VSI_STREAM_IRQ_BLOCK_Msk        (1UL << 0)
+
+/* Return code */
+#define VSI_STREAM_OK                   (0)         ///< Operation succeeded
+#define VSI_STREAM_ERROR                (-1)        ///< Unspecified error
+#define VSI_STREAM_ERROR_BUSY           (-2)        ///< Instance already bound or stream active
+#define VSI_STREAM_ERROR_PARAMETER      (-5)        ///< Parameter error
+
+struct VSI_Stream_s;
+
+/// \brief       Stream interrupt callback function type.
+/// \param[in]   stream         stream handle
+/// \param[in]   irq_status     peripheral IRQ status (already cleared)
+/// \return      none
+typedef void (*VSI_Stream_Event_t) (struct VSI_Stream_s *stream, uint32_t irq_status);
+
+/// VSI stream handle
+typedef struct VSI_Stream_s {
+  ARM_VSI_Type      *vsi;               ///< Peripheral access struct
+  uint32_t           instance;          ///< VSI instance number (0..7)
+  uint32_t           irq_mask;          ///< Enabled IRQ sources
+  VSI_Stream_Event_t cb_event;          ///< Interrupt callback
+  void              *context;           ///< User context for callback
+  uint8_t           *buf;               ///< Block ring start address
+  uint32_t           block_num;         ///< Number of blocks in ring (2^n)
+  uint32_t           block_size;        ///< Block size in bytes
+  volatile uint32_t  block_in;          ///< Producer index: blocks transferred by DMA
+  volatile uint32_t  block_out;         ///< Consumer index: blocks released
+  volatile uint32_t  overrun;           ///< Overrun flag (input ring lapped unreleased blocks)
+  uint32_t           interval;          ///< Block interval integer part (microseconds)
+  uint32_t           interval_cur;      ///< Block interval currently programmed in Timer
+  uint32_t           period_rem;        ///< Block interval fractional part numerator
+  uint32_t           period_den;        ///< Block interval fractional part denominator
+  uint32_t           period_acc;        ///< Accumulated fractional error
+} VSI_Stream_t;
+
+/// \brief       Bind stream to VSI peripheral instance and enable its interrupt.
+/// \param[in]   stream         stream handle
+/// \param[in]   instance       VSI instance number (0..7)
+/// \param[in]   irq_mask       IRQ sources to enable
+/// \param[in]   cb_event       interrupt callback (may be NULL)
+/// \param[in]   context        user context for callback
+/// \return      return code
+int32_t VSI_Stream_Bind (VSI_Stream_t *stream, uint32_t instance, uint32_t irq_mask, VSI_Stream_Event_t cb_event, void *context);
+
+/// \brief       Stop stream, disable its interrupt and release VSI peripheral instance.
+/// \param[in]   stream         stream handle
+/// \return      return code
+int32_t VSI_Stream_Unbind (VSI_Stream_t *stream);
+
+/// \brief       Set stream block ring buffer.
+/// \param[in]   stream         stream handle
+/// \param[in]   buf            pointer to buffer
+/// \param[in]   block_num      number of blocks in buffer (must be 2^n)
+/// \param[in]   block_size     block size in bytes (multiple of 4)
+/// \return      return code
+int32_t VSI_Stream_SetBuf (VSI_Stream_t *stream, void *buf, uint32_t block_num, uint32_t block_size);
+
+/// \brief       Set stream block interval.
+/// \param[in]   stream         stream handle
+/// \param[in]   interval       block interval in microseconds
+/// \return      none
+void VSI_Stream_SetInterval (VSI_Stream_t *stream, uint32_t interval);
+
+/// \brief       Set stream block period as a fraction of microseconds.
+/// \details     With fractional pacing the Timer interval alternates between the two
+///              nearest whole microsecond values so that the accumulated error stays
+///              below one microsecond, otherwise the period is truncated.
+/// \param[in]   stream         stream handle
+/// \param[in]   num            block period numerator (microseconds)
+/// \param[in]   den            block period denominator
+/// \param[in]   fractional     0=truncate period, 1=fractional pacing
+/// \return      none
+void VSI_Stream_SetPeriod (VSI_Stream_t *stream, uint64_t num, uint32_t den, uint32_t fractional);
+
+/// \brief       Get effective stream block period.
+/// \param[in]   stream         stream handle
+/// \param[out]  num            block period numerator (microseconds)
+/// \param[out]  den            block period denominator
+/// \return      none
+void VSI_Stream_GetPeriod (VSI_Stream_t *stream, uint64_t *num, uint32_t *den);
+
+/// \brief       Start DMA and Timer of the stream.
+/// \details     The block sequence continues monotonically: unreleased blocks are kept
+///              when the DMA continues with the next block of the ring.
+/// \param[in]   stream         stream handle
+/// \param[in]   direction      \ref VSI_STREAM_INPUT or \ref VSI_STREAM_OUTPUT
+/// \param[in]   mode           \ref VSI_STREAM_SINGLE or \ref VSI_STREAM_PERIODIC
+/// \return      number of unreleased blocks dropped (the DMA continues at another ring position)
+uint32_t VSI_Stream_Start (VSI_Stream_t *stream, uint32_t direction, uint32_t mode);
+
+/// \brief       Stop DMA and Timer of the stream.
+/// \param[in]   stream         stream handle
+/// \return      none
+void VSI_Stream_Stop (VSI_Stream_t *stream);
+
+/// \brief       Trigger a single block transfer of a started stream.
+/// \details     Restarts the Timer in single mode without touching DMA and ring state,
+///              the block is transferred after the programmed interval.
+/// \param[in]   stream         stream handle
+/// \return      none
+void VSI_Stream_Trigger (VSI_Stream_t *stream);
+
+/// \brief       Get oldest transferred block not yet released.
+/// \param[in]   stream         stream handle
+/// \return      pointer to block, NULL if no block is available
+void *VSI_Stream_GetBlock (VSI_Stream_t *stream);
+
+/// \brief       Release block obtained with \ref VSI_Stream_GetBlock.
+/// \param[in]   stream         stream handle
+/// \return      return code
+int32_t VSI_Stream_ReleaseBlock (VSI_Stream_t *stream);
+
+/// \brief       Get number of Timer events since the stream was started.
+/// \param[in]   stream         stream handle
+/// \return      Timer overflow count
+uint32_t VSI_Stream_GetCount (VSI_Stream_t *stream);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif  /* VSI_STREAM_H */
@@ -37,23 +37,22 @@ limitations under the License.
 #define DATA_SAMPLE_RATE  (20)                // Amount of samples per second
 #define DATA_NUM_ELEMENTS (20)                // Amount of samples in a DMA block
 
-#define SENSOR_BLOCK_NUM (1)                  // Amount of DMA blocks in DMA buffer,(must be 2^n)
+#define SENSOR_BLOCK_NUM (4)                  // Amount of DMA blocks in DMA buffer,(must be 2^n)
 #define SENSOR_BLOCK_SIZE (DATA_NUM_ELEMENTS * sizeof(DATA_NUM_TYPE)) // Size of DMA block in bytes, ( must be multiple of 4)
 
 #define SENSOR_BUFFER_SIZE (SENSOR_BLOCK_NUM * SENSOR_BLOCK_SIZE)     // Size of DMA buffer
 
 extern osThreadId_t app_main_tid;
 
-__attribute__((aligned(4)))
-DATA_NUM_TYPE sensor_data[SENSOR_BLOCK_SIZE];
-
 __attribute__((aligned(4)))
 DATA_NUM_TYPE sensor_dma_buffer[SENSOR_BUFFER_SIZE];
 
-extern void int_array_to_string(size_t num, DATA_NUM_TYPE* src, char* dst);
-
 uint8_t is_sensor_ready = 0;
 
+static uint32_t rx_block_cnt = 0;             // Number of processed blocks
+
+static void print_rx_blocks(void);
+
 
 void sensor_event(uint32_t event);
 
@@ -70,7 +69,6 @@ void app_init()
     }
 }
 
-uint32_t sensor_data_size = 0;
 /*---------------------------------------------------------------------------
  * User application run
  *---------------------------------------------------------------------------*/
@@ -91,11 +89,23 @@ void app_run()
     return;
   }
 
+  /* Ready before enabling: in free-running mode the ring can fill right away,
+     and blocks whose event was not signalled would never be processed */
+  is_sensor_ready = 1;
+
   /* Enable Sensor operation in receive mode */
+#ifdef __FREE_RUN
+  /* Unthrottled: next block is delivered as soon as the ring has room */
+  if (SensorDrv_Control(SENSOR_DRV_CONTROL_RX_ENABLE | SENSOR_DRV_CONTROL_RX_FREE_RUN)) {
+#else
   if (SensorDrv_Control(SENSOR_DRV_CONTROL_RX_ENABLE)) {
+#endif
+    is_sensor_ready = 0;
     log_error("Failed to configure sensor input");
     return;
   }
+  uint32_t start_tick = osKernelGetTickCount();
+  uint32_t end_tick   = start_tick;         // tick of the last processed block
 
 #ifdef __GATED_FETCH
   /* Puase sensor rx operation */
@@ -103,13 +113,8 @@ void app_run()
     log_error("Failed to configure sensor input");
     return;
   }
-  
-  uint32_t rx_count = 0;
 #endif
 
-  is_sensor_ready = 1;
-  sensor_data_size = SENSOR_BLOCK_SIZE;
-
   /* Loop for obtaining samples */
   while (1) {
 
@@ -123,28 +128,28 @@ void app_run()
 #ifdef __GATED_FETCH
     osDelay(10000U);                 // delay between fetching sensor data
 
-    SensorDrv_Control(SENSOR_DRV_CONTROL_RX_RESUME); // resume sensor rx operation
-    rx_count = SensorDrv_GetRxCount();
-
-    /* wait until number of received blocks is incremented */
-    while ((SensorDrv_GetRxCount() <= rx_count)){
-      osDelay(1U);
+    /* fetch one block (sensor rx pauses again by itself) and wait for it;
+       on timeout exit if sensor rx operation is disabled (end of data) */
+    uint32_t timeout = 2*((DATA_NUM_ELEMENTS*1000)/DATA_SAMPLE_RATE);  //double the time expected for sensor reading in ms
+    SensorDrv_Control(SENSOR_DRV_CONTROL_RX_FETCH | SENSOR_DRV_CONTROL_RX_FETCH_COUNT(1U));
+    if (SensorDrv_WaitRx(1U, timeout) != SENSOR_DRV_OK) {
+      if (SensorDrv_GetStatus().rx_active == 0U) {break;}
+      continue;
     }
-
-    SensorDrv_Control(SENSOR_DRV_CONTROL_RX_PAUSE);           // pause sensor rx operation
-
-    memcpy(sensor_data, sensor_dma_buffer, sensor_data_size); // copy from sensor DMA buffer
-
-    if(SensorDrv_GetStatus().rx_active == 0U) {break;}        // exit if sensor rx operation is disabled (end of data)
 #endif
 
     /* Print out received sensor samples */
-    char printing_text[265];
-    int_array_to_string(DATA_NUM_ELEMENTS, sensor_data, printing_text);
-    log_info("Received data: %s", printing_text);
+    uint32_t cnt = rx_block_cnt;
+    print_rx_blocks();
+    if (rx_block_cnt != cnt) {
+      end_tick = osKernelGetTickCount();
+    }
   }
 
+  /* End of data is detected by the timeout, which is not part of the processing time */
   log_info("Sensor Stream stopped");
+  log_info("Processed %u blocks in %u ms", rx_block_cnt,
+           (uint32_t)(((uint64_t)(end_tick - start_tick) * 1000U) / osKernelGetTickFreq()));
   is_sensor_ready = 0;
   SensorDrv_Uninitialize();
 
@@ -152,23 +157,16 @@ void app_run()
 }
 
 /*---------------------------------------------------------------------------
- * Utility function for converting array to string 
+ * Process all received blocks in place in the sensor DMA buffer
  *---------------------------------------------------------------------------*/
-void int_array_to_string(size_t num, DATA_NUM_TYPE* src, char* dst)
+static void print_rx_blocks(void)
 {
-  int num_chars = 0;
-
-  for(int x = 0; x < num; x++)
-  {
-    uint32_t val = (uint32_t)src[x];
-    sprintf(&dst[num_chars], "%d ", val);
-    num_chars += 2;
+  DATA_NUM_TYPE *block;
 
-    while(val >= 10)
-    {
-       num_chars += 1;
-       val /= 10;
-    }
+  while ((block = SensorDrv_GetRxBlock()) != NULL) {
+    log_info_array("Received data: %s", block, DATA_NUM_ELEMENTS);  // formatted (or tokenized) before release
+    SensorDrv_ReleaseRxBlock();                               // return block to sensor DMA
+    rx_block_cnt++;
   }
 }
 
@@ -183,7 +181,6 @@ void sensor_event(uint32_t event)
     /* Received sensor data */
     if (event & SENSOR_DRV_EVENT_RX_DATA)
     {
-      memcpy(sensor_data, sensor_dma_buffer, sensor_data_size);  // copy from sensor DMA buffer
       osThreadFlagsSet(app_main_tid, 0x1U);                      // issue thread flag to process data
     }
   }
@@ -0,0 +1,340 @@
+/* Copyright 2026 Arm Limited. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+/*
+ * Sensor loopback benchmark (build type: bench)
+ *
+ * Streams blocks out through the sensor transmitter and in through the sensor
+ * receiver for a sweep of sample rates and block sizes, and reports per run:
+ *  - expected blocks (from run time and rate) against Timer counts
+ *    (SensorDrv_GetRxCount/SensorDrv_GetTxCount) and delivered blocks
+ *  - dropped blocks (received by DMA but lapped before the application got them)
+ *  - callback latency (sensor event callback to application thread, in cycles)
+ *  - CPU cycles spent by the application per received block
+ *
+ * Before the sweep, the sensor processing kernels (sensor_proc.c) are timed
+ * against their scalar reference implementations.
+ */
+
+#ifdef _RTE_
+#include "RTE_Components.h"
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+#include CMSIS_device_header  // Device-specific defines and CMSIS-Core
+#include "cmsis_os2.h"        // CMSIS-RTOS2 API
+#include "micro_logger.h"     // Application logging engine to UART
+#include "sensor_drv.h"       // Sensor Driver API
+#include "sensor_proc.h"      // Sensor processing kernels
+
+#define BENCH_SAMPLE_BITS     (8U)            // Sample bits (matches intdata.txt)
+#define BENCH_CHANNELS        (1U)            // Number of channels
+#define BENCH_BLOCK_NUM       (8U)            // Amount of DMA blocks in DMA buffer (must be 2^n)
+#define BENCH_BLOCK_SIZE_MAX  (1024U)         // Largest block size in the sweep (in bytes)
+#define BENCH_RUN_TIME        (1000U)         // Duration of a single run (in ms)
+
+#define BENCH_KERNEL_SAMPLES  (1024U)         // Samples processed per kernel call
+#define BENCH_KERNEL_CHANNELS (3U)            // Channels for de-interleave (gather path)
+
+#define BENCH_FLAG_RX         (0x1U)          // Thread flag: block received
+
+extern osThreadId_t app_main_tid;
+
+/* Sweep: sample rates (samples per second) and block sizes (in samples, multiple of 4) */
+static const uint32_t bench_rates[]  = { 1000U, 8000U, 16000U, 48000U, 96000U, 192000U };
+static const uint32_t bench_blocks[] = { 64U, 256U, BENCH_BLOCK_SIZE_MAX };
+
+#define ARRAY_SIZE(a)         (sizeof(a) / sizeof((a)[0]))
+
+__attribute__((aligned(4)))
+static uint8_t rx_dma_buffer[BENCH_BLOCK_NUM * BENCH_BLOCK_SIZE_MAX];
+__attribute__((aligned(4)))
+static uint8_t tx_dma_buffer[BENCH_BLOCK_NUM * BENCH_BLOCK_SIZE_MAX];
+
+/* Kernel benchmark buffers */
+static int8_t  k_s8 [BENCH_KERNEL_SAMPLES];
+static int16_t k_s16[BENCH_KERNEL_SAMPLES];
+static int32_t k_s32[BENCH_KERNEL_SAMPLES];
+static int16_t k_q15[BENCH_KERNEL_SAMPLES];
+static float   k_f32[BENCH_KERNEL_SAMPLES];
+static float   k_f32_out[BENCH_KERNEL_SAMPLES];
+
+/* Counters updated from the sensor event callback */
+static volatile uint32_t rx_events;
+static volatile uint32_t tx_events;
+static volatile uint32_t rx_event_cycles;
+
+/* Result of a single run */
+typedef struct {
+  uint32_t expected;                          // Blocks expected for the run time
+  uint32_t rx_count;                          // Receiver Timer events
+  uint32_t tx_count;                          // Transmitter Timer events
+  uint32_t rx_events;                         // Receiver callbacks
+  uint32_t tx_events;                         // Transmitter callbacks
+  uint32_t delivered;                         // Blocks processed by the application
+  uint32_t dropped;                           // Blocks lapped by DMA before processing
+  uint32_t rate;                              // Effective receiver sample rate
+  uint32_t latency_avg;                       // Callback to thread latency (cycles)
+  uint32_t latency_max;
+  uint32_t cycles_per_block;                  // Application cycles per block
+  uint32_t eof;                               // Receiver stopped (end of sensor data)
+} bench_result_t;
+
+/*---------------------------------------------------------------------------
+ * Cycle counter (Arm PMU cycle counter, DWT CYCCNT when no PMU is present)
+ *---------------------------------------------------------------------------*/
+static void cycle_counter_init(void)
+{
+#if defined(__PMU_PRESENT) && (__PMU_PRESENT == 1U)
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+  ARM_PMU_Enable();
+  ARM_PMU_CYCCNT_Reset();
+  ARM_PMU_CNTR_Enable(PMU_CNTENSET_CCNTR_ENABLE_Msk);
+#else
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0U;
+  DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+static inline uint32_t cycle_counter_get(void)
+{
+#if defined(__PMU_PRESENT) && (__PMU_PRESENT == 1U)
+  return ARM_PMU_Get_CCNTR();
+#else
+  return DWT->CYCCNT;
+#endif
+}
+
+/*---------------------------------------------------------------------------
+ * Sensor processing kernels: scalar reference against Helium (when available)
+ *---------------------------------------------------------------------------*/
+static void bench_kernel_report(const char *name, uint32_t scalar, uint32_t vector)
+{
+  uint32_t speedup = (vector != 0U) ? ((scalar * 100U) / vector) : 0U;
+
+  log_info("%-18s %-8u %-8u %u.%02u", name, scalar, vector, speedup / 100U, speedup % 100U);
+}
+
+/* Time scalar and vector call (after one warm-up call of each) */
+#define BENCH_KERNEL(name, call_scalar, call_vector)                            \
+  do {                                                                          \
+    uint32_t t0, t1, t2;                                                        \
+    call_scalar;                                                                \
+    call_vector;                                                                \
+    t0 = cycle_counter_get();                                                   \
+    call_scalar;                                                                \
+    t1 = cycle_counter_get();                                                   \
+    call_vector;                                                                \
+    t2 = cycle_counter_get();                                                   \
+    bench_kernel_report(name, t1 - t0, t2 - t1);                                \
+  } while (0)
+
+static void bench_kernels(void)
+{
+  const uint32_t     n      = BENCH_KERNEL_SAMPLES;
+  const uint32_t     frames = BENCH_KERNEL_SAMPLES / BENCH_KERNEL_CHANNELS;
+  SensorProc_Stats_t stats;
+
+  for (uint32_t i = 0U; i < n; i++) {
+    k_s8[i]  = (int8_t)(i * 37U);
+    k_s16[i] = (int16_t)(i * 4099U);
+    k_s32[i] = (int32_t)(i * 268435399U);
+    k_f32[i] = (float)k_s16[i];
+  }
+
+  log_info("Sensor processing kernels: %u samples, cycles per call", n);
+  log_info("kernel             scalar   vector   speedup");
+
+  BENCH_KERNEL("S8ToQ15",        SensorProc_S8ToQ15_Scalar(k_s8, k_q15, n),   SensorProc_S8ToQ15(k_s8, k_q15, n));
+  BENCH_KERNEL("S32ToQ15",       SensorProc_S32ToQ15_Scalar(k_s32, k_q15, n), SensorProc_S32ToQ15(k_s32, k_q15, n));
+  BENCH_KERNEL("S8ToF32",        SensorProc_S8ToF32_Scalar(k_s8, k_f32_out, n),   SensorProc_S8ToF32(k_s8, k_f32_out, n));
+  BENCH_KERNEL("S16ToF32",       SensorProc_S16ToF32_Scalar(k_s16, k_f32_out, n), SensorProc_S16ToF32(k_s16, k_f32_out, n));
+  BENCH_KERNEL("S32ToF32",       SensorProc_S32ToF32_Scalar(k_s32, k_f32_out, n), SensorProc_S32ToF32(k_s32, k_f32_out, n));
+  BENCH_KERNEL("DeinterleaveQ15/2", SensorProc_DeinterleaveQ15_Scalar(k_s16, k_q15, 2U, n / 2U),
+                                    SensorProc_DeinterleaveQ15(k_s16, k_q15, 2U, n / 2U));
+  BENCH_KERNEL("DeinterleaveQ15/3", SensorProc_DeinterleaveQ15_Scalar(k_s16, k_q15, BENCH_KERNEL_CHANNELS, frames),
+                                    SensorProc_DeinterleaveQ15(k_s16, k_q15, BENCH_KERNEL_CHANNELS, frames));
+  BENCH_KERNEL("DeinterleaveF32/2", SensorProc_DeinterleaveF32_Scalar(k_f32, k_f32_out, 2U, n / 2U),
+                                    SensorProc_DeinterleaveF32(k_f32, k_f32_out, 2U, n / 2U));
+  BENCH_KERNEL("DeinterleaveF32/3", SensorProc_DeinterleaveF32_Scalar(k_f32, k_f32_out, BENCH_KERNEL_CHANNELS, frames),
+                                    SensorProc_DeinterleaveF32(k_f32, k_f32_out, BENCH_KERNEL_CHANNELS, frames));
+  BENCH_KERNEL("StatsS8",        SensorProc_StatsS8_Scalar(k_s8, n, &stats),   SensorProc_StatsS8(k_s8, n, &stats));
+  BENCH_KERNEL("StatsS16",       SensorProc_StatsS16_Scalar(k_s16, n, &stats), SensorProc_StatsS16(k_s16, n, &stats));
+  BENCH_KERNEL("StatsS32",       SensorProc_StatsS32_Scalar(k_s32, n, &stats), SensorProc_StatsS32(k_s32, n, &stats));
+}
+
+/*---------------------------------------------------------------------------
+ * Sensor event callback
+ *---------------------------------------------------------------------------*/
+static void sensor_event(uint32_t event)
+{
+  if (event & SENSOR_DRV_EVENT_RX_DATA)
+  {
+    rx_event_cycles = cycle_counter_get();
+    rx_events++;
+    osThreadFlagsSet(app_main_tid, BENCH_FLAG_RX);
+  }
+  if (event & SENSOR_DRV_EVENT_TX_DATA)
+  {
+    tx_events++;
+  }
+}
+
+/*---------------------------------------------------------------------------
+ * Run loopback for one sample rate and block size
+ *---------------------------------------------------------------------------*/
+static int32_t bench_run(uint32_t sample_rate, uint32_t block_size, bench_result_t *res)
+{
+  uint32_t rx_start, tx_start;
+  uint32_t t_start, t_end;
+  uint64_t latency_sum = 0U;
+  uint32_t latency_num = 0U;
+  uint64_t cycles      = 0U;
+  uint32_t checksum    = 0U;
+  uint8_t *block;
+
+  memset(res, 0, sizeof(*res));
+
+  if (SensorDrv_Configure(SENSOR_DRV_INTERFACE_TX, BENCH_CHANNELS, BENCH_SAMPLE_BITS, sample_rate) ||
+      SensorDrv_Configure(SENSOR_DRV_INTERFACE_RX, BENCH_CHANNELS, BENCH_SAMPLE_BITS, sample_rate) ||
+      SensorDrv_SetBuf(SENSOR_DRV_INTERFACE_TX, tx_dma_buffer, BENCH_BLOCK_NUM, block_size) ||
+      SensorDrv_SetBuf(SENSOR_DRV_INTERFACE_RX, rx_dma_buffer, BENCH_BLOCK_NUM, block_size)) {
+    return -1;
+  }
+
+  rx_events = 0U;
+  tx_events = 0U;
+  osThreadFlagsClear(BENCH_FLAG_RX);
+
+  rx_start = SensorDrv_GetRxCount();
+  tx_start = SensorDrv_GetTxCount();
+  (void)SensorDrv_GetStatus();                // clear stale overrun indication
+
+  if (SensorDrv_Control(SENSOR_DRV_CONTROL_TX_ENABLE | SENSOR_DRV_CONTROL_RX_ENABLE | SENSOR_DRV_CONTROL_HIGH_RATE)) {
+    return -1;
+  }
+  t_start = osKernelGetTickCount();
+
+  while ((osKernelGetTickCount() - t_start) < BENCH_RUN_TIME) {
+    if ((int32_t)osThreadFlagsWait(BENCH_FLAG_RX, osFlagsWaitAny, 100U) < 0) {
+      if (SensorDrv_GetStatus().rx_active == 0U) {
+        res->eof = 1U;                        // end of sensor data file
+        break;
+      }
+      continue;
+    }
+
+    uint32_t t0 = cycle_counter_get();
+    uint32_t latency = t0 - rx_event_cycles;
+    latency_sum += latency;
+    latency_num++;
+    if (latency > res->latency_max) {
+      res->latency_max = latency;
+    }
+
+    while ((block = SensorDrv_GetRxBlock()) != NULL) {
+      for (uint32_t i = 0U; i < block_size; i += 4U) {
+        checksum += *(uint32_t *)&block[i];   // touch the received data
+      }
+      SensorDrv_ReleaseRxBlock();
+      res->delivered++;
+    }
+    cycles += cycle_counter_get() - t0;
+  }
+
+  SensorDrv_Control(SENSOR_DRV_CONTROL_TX_DISABLE | SENSOR_DRV_CONTROL_RX_DISABLE);
+  t_end = osKernelGetTickCount();
+
+  /* Blocks still in the ring are delivered, not dropped */
+  while (SensorDrv_GetRxBlock() != NULL) {
+    SensorDrv_ReleaseRxBlock();
+    res->delivered++;
+  }
+
+  res->rx_count  = SensorDrv_GetRxCount() - rx_start;
+  res->tx_count  = SensorDrv_GetTxCount() - tx_start;
+  res->rx_events = rx_events;
+  res->tx_events = tx_events;
+  res->rate      = SensorDrv_GetRate(SENSOR_DRV_INTERFACE_RX);
+  res->expected  = (uint32_t)(((uint64_t)(t_end - t_start) * sample_rate) /
+                              ((uint64_t)block_size * osKernelGetTickFreq()));
+  res->dropped   = (res->rx_events > res->delivered) ? (res->rx_events - res->delivered) : 0U;
+  if (latency_num != 0U) {
+    res->latency_avg = (uint32_t)(latency_sum / latency_num);
+  }
+  if (res->delivered != 0U) {
+    res->cycles_per_block = (uint32_t)(cycles / res->delivered);
+  }
+  (void)checksum;
+
+  return 0;
+}
+
+/*---------------------------------------------------------------------------
+ * Application main thread
+ *---------------------------------------------------------------------------*/
+__NO_RETURN void app_main(void *argument)
+{
+  bench_result_t res;
+  uint32_t       max_rate;
+  (void)argument;
+
+  cycle_counter_init();
+  bench_kernels();
+
+  if (SensorDrv_Initialize(sensor_event)) {
+    log_error("Failed to initialise sensor driver");
+    for (;;){;}
+  }
+
+  /* Pattern for transmitted blocks */
+  for (uint32_t i = 0U; i < sizeof(tx_dma_buffer); i++) {
+    tx_dma_buffer[i] = (uint8_t)i;
+  }
+
+  log_info("Sensor loopback benchmark: %u ms per run, %u blocks in ring", BENCH_RUN_TIME, BENCH_BLOCK_NUM);
+  log_info("rate    block expected rx_cnt tx_cnt deliv  drop  eff_rate lat_avg lat_max cyc/blk");
+
+  for (uint32_t b = 0U; b < ARRAY_SIZE(bench_blocks); b++) {
+    max_rate = 0U;
+
+    for (uint32_t r = 0U; r < ARRAY_SIZE(bench_rates); r++) {
+      if (bench_run(bench_rates[r], bench_blocks[b], &res) != 0) {
+        log_error("Failed to configure sensor for rate %u, block %u", bench_rates[r], bench_blocks[b]);
+        continue;
+      }
+
+      log_info("%-7u %-5u %-8u %-6u %-6u %-6u %-5u %-8u %-7u %-7u %-7u%s",
+               bench_rates[r], bench_blocks[b], res.expected, res.rx_count, res.tx_count,
+               res.delivered, res.dropped, res.rate, res.latency_avg, res.latency_max,
+               res.cycles_per_block, (res.eof != 0U) ? " (end of data)" : "");
+
+      /* Sustainable: nothing dropped and all expected blocks delivered (one block tolerance) */
+      if ((res.eof == 0U) && (res.dropped == 0U) && ((res.delivered + 1U) >= res.expected)) {
+        max_rate = bench_rates[r];
+      }
+    }
+
+    log_info("Block size %u: maximum sustainable rate %u samples/s", bench_blocks[b], max_rate);
+  }
+
+  SensorDrv_Uninitialize();
+  log_info("Benchmark completed");
+
+  for (;;){;}
+}
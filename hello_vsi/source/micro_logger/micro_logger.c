@@ -14,9 +14,18 @@ limitations under the License.
 ==============================================================================*/
 
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
+#include "micro_logger.h"
+
+#ifdef MICRO_LOGGER_TOKENIZED
+#include "RTE_Components.h"
+#include CMSIS_device_header
+#include "cmsis_os2.h"
+#endif
+
 enum LOG_LEVEL
 {
     ERROR = 0,
@@ -26,6 +35,8 @@ enum LOG_LEVEL
 };
 static enum LOG_LEVEL log_level = INFO;
 
+#ifndef MICRO_LOGGER_TOKENIZED
+
 void print_log_string_to_each_line(char* log_message, const char* log_type)
 {
     char buffer[1024];
@@ -101,3 +112,210 @@ extern void log_debug(const char* format, ...)
 
     va_end(args);
 }
+
+void log_init(void)
+{
+}
+
+/* Append unsigned decimal value to text, returns new end */
+static char* append_uint(char* dst, uint32_t val)
+{
+    char digits[10];
+    int n = 0;
+
+    do {
+        digits[n++] = (char)('0' + (val % 10U));
+        val /= 10U;
+    } while (val != 0U);
+
+    while (n > 0) {
+        *dst++ = digits[--n];
+    }
+    return dst;
+}
+
+void log_array(uint32_t level, const char* format, const void* data, uint32_t count, uint32_t elem_size)
+{
+    char text[1024];
+    char* p = text;
+    uint32_t val;
+    uint32_t max;
+    size_t fmt_len;
+
+    if (log_level < level)
+        return;
+
+    /* Up to 10 digits and a separator per element, the formatted message
+       (format and text) must fit the 1024 byte log buffers */
+    fmt_len = strlen(format);
+    max = (fmt_len < (sizeof(text) - 1U)) ? (uint32_t)((sizeof(text) - 1U - fmt_len) / 11U) : 0U;
+    if (count > max)
+        count = max;
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        switch (elem_size)
+        {
+            case 1U:  val = ((const uint8_t*)data)[i];  break;
+            case 2U:  val = ((const uint16_t*)data)[i]; break;
+            default:  val = ((const uint32_t*)data)[i]; break;
+        }
+        p = append_uint(p, val);
+        *p++ = ' ';
+    }
+    *p = '\0';
+
+    switch (level)
+    {
+        case MICRO_LOGGER_LEVEL_ERROR:   log_error(format, text);   break;
+        case MICRO_LOGGER_LEVEL_WARNING: log_warning(format, text); break;
+        case MICRO_LOGGER_LEVEL_INFO:    log_info(format, text);    break;
+        default:                         log_debug(format, text);   break;
+    }
+}
+
+#else /* MICRO_LOGGER_TOKENIZED */
+
+/*
+ * Log record in the ring buffer (32-bit words):
+ *   [0]  format string address (token)
+ *   [1]  level[31:24] | element size[23:16] (0 = arguments) | payload words[15:0]
+ *   [2]  kernel tick count
+ *   [3]  payload: arguments, or element count followed by packed elements
+ *
+ * Drained to stdout as one line per record: "@L" followed by the words in hex.
+ */
+
+#ifndef MICRO_LOGGER_RING_WORDS
+#define MICRO_LOGGER_RING_WORDS     (2048U)     /* Ring buffer size in words (must be 2^n) */
+#endif
+#ifndef MICRO_LOGGER_DRAIN_PERIOD
+#define MICRO_LOGGER_DRAIN_PERIOD   (10U)       /* Drain thread period (in ms) */
+#endif
+
+#define LOG_RECORD_HEADER_WORDS     (3U)
+
+static uint32_t          log_ring[MICRO_LOGGER_RING_WORDS];
+static volatile uint32_t log_head = 0U;         /* Written by producers (under lock) */
+static volatile uint32_t log_tail = 0U;         /* Written by drain thread */
+static volatile uint32_t log_dropped = 0U;
+
+static uint64_t          log_drain_stack[1024 / 8];
+static const osThreadAttr_t log_drain_attr = {
+    .name       = "log_drain",
+    .stack_mem  = log_drain_stack,
+    .stack_size = sizeof(log_drain_stack),
+    .priority   = osPriorityLow
+};
+
+/* Store record into ring buffer (thread and interrupt safe) */
+static void log_write(uint32_t level, const char* format, uint32_t elem_size,
+                      const uint32_t* args, uint32_t num, const void* data, uint32_t size)
+{
+    uint32_t words = LOG_RECORD_HEADER_WORDS + num + ((size + 3U) / 4U);
+    uint32_t primask;
+    uint32_t head;
+    uint32_t i;
+
+    if (log_level < level)
+        return;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    head = log_head;
+    if ((MICRO_LOGGER_RING_WORDS - (head - log_tail)) < words)
+    {
+        log_dropped++;
+        __set_PRIMASK(primask);
+        return;
+    }
+
+    log_ring[head++ & (MICRO_LOGGER_RING_WORDS - 1U)] = (uint32_t)format;
+    log_ring[head++ & (MICRO_LOGGER_RING_WORDS - 1U)] = (level << 24) | (elem_size << 16) | (words - LOG_RECORD_HEADER_WORDS);
+    log_ring[head++ & (MICRO_LOGGER_RING_WORDS - 1U)] = osKernelGetTickCount();
+    for (i = 0U; i < num; i++)
+    {
+        log_ring[head++ & (MICRO_LOGGER_RING_WORDS - 1U)] = args[i];
+    }
+    for (i = 0U; i < size; i += 4U)
+    {
+        uint32_t w = 0U;
+        memcpy(&w, (const uint8_t*)data + i, ((size - i) < 4U) ? (size - i) : 4U);
+        log_ring[head++ & (MICRO_LOGGER_RING_WORDS - 1U)] = w;
+    }
+    log_head = head;
+
+    __set_PRIMASK(primask);
+}
+
+void log_token(uint32_t level, const char* format, const uint32_t* args, uint32_t num)
+{
+    log_write(level, format, 0U, args, num, NULL, 0U);
+}
+
+void log_array(uint32_t level, const char* format, const void* data, uint32_t count, uint32_t elem_size)
+{
+    log_write(level, format, elem_size, &count, 1U, data, count * elem_size);
+}
+
+/* Drain ring buffer to stdout as hex records */
+static __NO_RETURN void log_drain(void* argument)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    static char line[4 + (9U * 64U) + 3];
+    uint32_t dropped = 0U;
+    uint32_t tail, words, w;
+    char*    p;
+    (void)argument;
+
+    for (;;)
+    {
+        osDelay(MICRO_LOGGER_DRAIN_PERIOD);
+
+        tail = log_tail;
+        while (tail != log_head)
+        {
+            words = LOG_RECORD_HEADER_WORDS + (log_ring[(tail + 1U) & (MICRO_LOGGER_RING_WORDS - 1U)] & 0xFFFFU);
+            p = line;
+            *p++ = '@';
+            *p++ = 'L';
+            for (uint32_t i = 0U; i < words; i++)
+            {
+                w = log_ring[(tail + i) & (MICRO_LOGGER_RING_WORDS - 1U)];
+                *p++ = ' ';
+                for (int32_t b = 28; b >= 0; b -= 4)
+                {
+                    *p++ = hex[(w >> b) & 0xFU];
+                }
+                if ((p - line) > (int32_t)(sizeof(line) - 12U))
+                {
+                    /* Long record: continue on the next line */
+                    *p++ = '\r'; *p++ = '\n'; *p = '\0';
+                    fputs(line, stdout);
+                    p = line;
+                    *p++ = '@';
+                    *p++ = '+';
+                }
+            }
+            *p++ = '\r'; *p++ = '\n'; *p = '\0';
+            fputs(line, stdout);
+
+            tail += words;
+            log_tail = tail;
+        }
+
+        if (log_dropped != dropped)
+        {
+            dropped = log_dropped;
+            printf("WARNING: %u log records dropped\r\n", (unsigned int)dropped);
+        }
+    }
+}
+
+void log_init(void)
+{
+    osThreadNew(log_drain, NULL, &log_drain_attr);
+}
+
+#endif /* MICRO_LOGGER_TOKENIZED */
@@ -17,9 +17,29 @@ limitations under the License.
 #define _MICRO_LOGGER_H_
 
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
+/* Log levels */
+#define MICRO_LOGGER_LEVEL_ERROR    (0U)
+#define MICRO_LOGGER_LEVEL_WARNING  (1U)
+#define MICRO_LOGGER_LEVEL_INFO     (2U)
+#define MICRO_LOGGER_LEVEL_DEBUG    (3U)
+
+/* Initialize logger (starts the drain thread in tokenized mode, call after osKernelInitialize) */
+extern void log_init(void);
+
+/* Log array of count integer elements of elem_size bytes, formatted in place of "%s" in format */
+extern void log_array(uint32_t level, const char* format, const void* data, uint32_t count, uint32_t elem_size);
+
+#define log_error_array(format, data, count)   log_array(MICRO_LOGGER_LEVEL_ERROR,   format, data, count, sizeof(*(data)))
+#define log_warning_array(format, data, count) log_array(MICRO_LOGGER_LEVEL_WARNING, format, data, count, sizeof(*(data)))
+#define log_info_array(format, data, count)    log_array(MICRO_LOGGER_LEVEL_INFO,    format, data, count, sizeof(*(data)))
+#define log_debug_array(format, data, count)   log_array(MICRO_LOGGER_LEVEL_DEBUG,   format, data, count, sizeof(*(data)))
+
+#ifndef MICRO_LOGGER_TOKENIZED
+
 extern void log_error(const char* format, ...);
 
 extern void log_warning(const char* format, ...);
@@ -28,4 +48,54 @@ extern void log_info(const char* format, ...);
 
 extern void log_debug(const char* format, ...);
 
+#else
+
+/*
+ * Tokenized logging
+ *
+ * Format strings are placed in the ".log_fmt" section and only their address
+ * (the token) and the raw 32-bit arguments are stored in a RAM ring buffer.
+ * A low-priority thread drains the ring to stdout as hex records that are
+ * turned back into text on the host by micro_logger_decode.py using the ELF.
+ * Arguments must be integers, characters, pointers or pointers to constant
+ * strings (resolved from the ELF); at most 12 arguments are supported.
+ */
+
+extern void log_token(uint32_t level, const char* format, const uint32_t* args, uint32_t num);
+
+#define LOG_NARG_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, N, ...) N
+#define LOG_NARG(...)           LOG_NARG_(0, ##__VA_ARGS__, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+
+#define LOG_CAT_(a, b)          a##b
+#define LOG_CAT(a, b)           LOG_CAT_(a, b)
+
+#define LOG_ARG_0()
+#define LOG_ARG_1(a)                                        (uint32_t)(a)
+#define LOG_ARG_2(a, b)                                     LOG_ARG_1(a), (uint32_t)(b)
+#define LOG_ARG_3(a, b, c)                                  LOG_ARG_2(a, b), (uint32_t)(c)
+#define LOG_ARG_4(a, b, c, d)                               LOG_ARG_3(a, b, c), (uint32_t)(d)
+#define LOG_ARG_5(a, b, c, d, e)                            LOG_ARG_4(a, b, c, d), (uint32_t)(e)
+#define LOG_ARG_6(a, b, c, d, e, f)                         LOG_ARG_5(a, b, c, d, e), (uint32_t)(f)
+#define LOG_ARG_7(a, b, c, d, e, f, g)                      LOG_ARG_6(a, b, c, d, e, f), (uint32_t)(g)
+#define LOG_ARG_8(a, b, c, d, e, f, g, h)                   LOG_ARG_7(a, b, c, d, e, f, g), (uint32_t)(h)
+#define LOG_ARG_9(a, b, c, d, e, f, g, h, i)                LOG_ARG_8(a, b, c, d, e, f, g, h), (uint32_t)(i)
+#define LOG_ARG_10(a, b, c, d, e, f, g, h, i, j)            LOG_ARG_9(a, b, c, d, e, f, g, h, i), (uint32_t)(j)
+#define LOG_ARG_11(a, b, c, d, e, f, g, h, i, j, k)         LOG_ARG_10(a, b, c, d, e, f, g, h, i, j), (uint32_t)(k)
+#define LOG_ARG_12(a, b, c, d, e, f, g, h, i, j, k, l)      LOG_ARG_11(a, b, c, d, e, f, g, h, i, j, k), (uint32_t)(l)
+#define LOG_ARGS(...)           LOG_CAT(LOG_ARG_, LOG_NARG(__VA_ARGS__))(__VA_ARGS__)
+
+#define LOG_TOKEN(level, format, ...)                                                   \
+  do {                                                                                  \
+    static const char log_fmt_[] __attribute__((section(".log_fmt"), used)) = format;  \
+    const uint32_t    log_args_[] = { 0U, LOG_ARGS(__VA_ARGS__) };                      \
+    log_token((level), log_fmt_, &log_args_[1], LOG_NARG(__VA_ARGS__));                \
+  } while (0)
+
+#define log_error(...)          LOG_TOKEN(MICRO_LOGGER_LEVEL_ERROR,   __VA_ARGS__)
+#define log_warning(...)        LOG_TOKEN(MICRO_LOGGER_LEVEL_WARNING, __VA_ARGS__)
+#define log_info(...)           LOG_TOKEN(MICRO_LOGGER_LEVEL_INFO,    __VA_ARGS__)
+#define log_debug(...)          LOG_TOKEN(MICRO_LOGGER_LEVEL_DEBUG,   __VA_ARGS__)
+
+#endif
+
 #endif
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "sensor_decim.h"
+#include "sensor_proc.h"
+
+/* Per-channel state length: history (taps - 1) followed by up to block_frames input samples */
+#define STATE_LEN(decim)        ((decim)->taps - 1U + (decim)->block_frames)
+
+/* Filter the staged input, write retained outputs and keep the history */
+static uint32_t Decim_Filter (SensorDecim_t *decim, int16_t *dst, uint32_t frames) {
+  const uint32_t len = STATE_LEN(decim);
+  int16_t       *x;
+  int64_t        acc;
+  uint32_t       out = 0U;
+  uint32_t       n;
+
+  /* Output at input frame n uses the window x[n - taps + 1 .. n], i.e. state[n .. n + taps - 1] */
+  for (n = decim->phase; n < frames; n += decim->factor) {
+    for (uint32_t c = 0U; c < decim->channels; c++) {
+      acc = SensorProc_DotQ15(decim->coeffs, &decim->state[(c * len) + n], decim->taps) >> 15;
+      if (acc > INT16_MAX) {
+        acc = INT16_MAX;
+      } else if (acc < INT16_MIN) {
+        acc = INT16_MIN;
+      }
+      dst[(out * decim->channels) + c] = (int16_t)acc;
+    }
+    out++;
+  }
+  decim->phase = n - frames;
+
+  /* Last taps - 1 input samples become the history of the next call */
+  for (uint32_t c = 0U; c < decim->channels; c++) {
+    x = &decim->state[c * len];
+    memmove(x, &x[frames], (decim->taps - 1U) * sizeof(int16_t));
+  }
+
+  return out;
+}
+
+/* Initialize decimator */
+int32_t SensorDecim_Init (SensorDecim_t *decim, const int16_t *coeffs, uint32_t taps, uint32_t factor,
+                          uint32_t channels, int16_t *state, uint32_t block_frames) {
+
+  if ((decim == NULL) || (coeffs == NULL) || (state == NULL) ||
+      (taps == 0U) || (factor == 0U) || (channels == 0U) || (block_frames == 0U)) {
+    return SENSOR_DECIM_ERROR_PARAMETER;
+  }
+
+  decim->coeffs       = coeffs;
+  decim->taps         = taps;
+  decim->factor       = factor;
+  decim->channels     = channels;
+  decim->block_frames = block_frames;
+  decim->state        = state;
+
+  SensorDecim_Reset(decim);
+
+  return SENSOR_DECIM_OK;
+}
+
+/* Clear filter history and output phase */
+void SensorDecim_Reset (SensorDecim_t *decim) {
+  memset(decim->state, 0, decim->channels * STATE_LEN(decim) * sizeof(int16_t));
+  decim->phase = 0U;
+}
+
+/* Get number of output frames for the next call */
+uint32_t SensorDecim_OutputFrames (const SensorDecim_t *decim, uint32_t frames) {
+  if (frames <= decim->phase) {
+    return 0U;
+  }
+  return (((frames - decim->phase) + decim->factor - 1U) / decim->factor);
+}
+
+/* Decimate int8 frames */
+uint32_t SensorDecim_ProcessS8 (SensorDecim_t *decim, const int8_t *src, int16_t *dst, uint32_t frames) {
+  const uint32_t len = STATE_LEN(decim);
+  int16_t       *x;
+
+  if (frames > decim->block_frames) {
+    frames = decim->block_frames;
+  }
+
+  /* Stage input behind the history, converted to Q15 and de-interleaved */
+  if (decim->channels == 1U) {
+    SensorProc_S8ToQ15(src, &decim->state[decim->taps - 1U], frames);
+  } else {
+    for (uint32_t c = 0U; c < decim->channels; c++) {
+      x = &decim->state[(c * len) + decim->taps - 1U];
+      for (uint32_t i = 0U; i < frames; i++) {
+        x[i] = (int16_t)((int32_t)src[(i * decim->channels) + c] * 256);
+      }
+    }
+  }
+
+  return (Decim_Filter(decim, dst, frames));
+}
+
+/* Decimate int16 frames */
+uint32_t SensorDecim_ProcessS16 (SensorDecim_t *decim, const int16_t *src, int16_t *dst, uint32_t frames) {
+  const uint32_t len = STATE_LEN(decim);
+  int16_t       *x;
+
+  if (frames > decim->block_frames) {
+    frames = decim->block_frames;
+  }
+
+  /* Stage input behind the history, de-interleaved */
+  if (decim->channels == 1U) {
+    memcpy(&decim->state[decim->taps - 1U], src, frames * sizeof(int16_t));
+  } else {
+    for (uint32_t c = 0U; c < decim->channels; c++) {
+      x = &decim->state[(c * len) + decim->taps - 1U];
+      for (uint32_t i = 0U; i < frames; i++) {
+        x[i] = src[(i * decim->channels) + c];
+      }
+    }
+  }
+
+  return (Decim_Filter(decim, dst, frames));
+}
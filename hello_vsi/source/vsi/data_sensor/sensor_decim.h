@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ */
+
+#ifndef __SENSOR_DECIM_H
+#define __SENSOR_DECIM_H
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/*
+ * Streaming FIR decimator
+ *
+ * Low-pass filters interleaved sensor frames and keeps every factor-th output.
+ * Only the retained outputs are computed (polyphase decimation), each as one
+ * Q15 dot product over the filter window (see SensorProc_DotQ15). Filter
+ * history and output phase persist across calls, so input can be fed in
+ * blocks of any size up to block_frames.
+ *
+ * Coefficients are Q15 and stored in time-reversed order (as for CMSIS-DSP
+ * arm_fir_decimate_q15); symmetric linear-phase filters need no reversal.
+ */
+
+/* Size of the state buffer in samples (int16_t) */
+#define SENSOR_DECIM_STATE_SIZE(taps, channels, block_frames) \
+  ((channels) * ((taps) - 1U + (block_frames)))
+
+/* Return code */
+#define SENSOR_DECIM_OK                 (0)         ///< Operation succeeded
+#define SENSOR_DECIM_ERROR_PARAMETER    (-5)        ///< Parameter error
+
+/**
+\brief Decimator instance
+*/
+typedef struct {
+  const int16_t *coeffs;                ///< Filter coefficients (Q15, time-reversed)
+  uint32_t       taps;                  ///< Number of filter coefficients
+  uint32_t       factor;                ///< Decimation factor
+  uint32_t       channels;              ///< Number of interleaved channels
+  uint32_t       block_frames;          ///< Maximum number of input frames per call
+  uint32_t       phase;                 ///< Input frames to skip before the next output
+  int16_t       *state;                 ///< Per-channel history followed by the current input
+} SensorDecim_t;
+
+/**
+  \fn          int32_t SensorDecim_Init (SensorDecim_t *decim, const int16_t *coeffs, uint32_t taps, uint32_t factor, uint32_t channels, int16_t *state, uint32_t block_frames)
+  \brief       Initialize decimator.
+  \param[out]  decim        decimator instance
+  \param[in]   coeffs       filter coefficients (Q15, time-reversed order)
+  \param[in]   taps         number of filter coefficients
+  \param[in]   factor       decimation factor (1 = filter only)
+  \param[in]   channels     number of interleaved channels
+  \param[in]   state        state buffer of \ref SENSOR_DECIM_STATE_SIZE samples
+  \param[in]   block_frames maximum number of input frames per call
+  \return      return code
+*/
+int32_t SensorDecim_Init (SensorDecim_t *decim, const int16_t *coeffs, uint32_t taps, uint32_t factor,
+                          uint32_t channels, int16_t *state, uint32_t block_frames);
+
+/**
+  \fn          void SensorDecim_Reset (SensorDecim_t *decim)
+  \brief       Clear filter history and output phase.
+  \param[in]   decim        decimator instance
+*/
+void SensorDecim_Reset (SensorDecim_t *decim);
+
+/**
+  \fn          uint32_t SensorDecim_OutputFrames (const SensorDecim_t *decim, uint32_t frames)
+  \brief       Get number of output frames the next call with frames input frames produces.
+  \param[in]   decim        decimator instance
+  \param[in]   frames       number of input frames
+  \return      number of output frames
+*/
+uint32_t SensorDecim_OutputFrames (const SensorDecim_t *decim, uint32_t frames);
+
+/**
+  \fn          uint32_t SensorDecim_ProcessS8 (SensorDecim_t *decim, const int8_t *src, int16_t *dst, uint32_t frames)
+  \brief       Decimate int8 frames (converted to Q15) into Q15 frames.
+  \param[in]   decim        decimator instance
+  \param[in]   src          interleaved input frames
+  \param[out]  dst          interleaved output frames
+  \param[in]   frames       number of input frames (up to block_frames)
+  \return      number of output frames
+*/
+uint32_t SensorDecim_ProcessS8 (SensorDecim_t *decim, const int8_t *src, int16_t *dst, uint32_t frames);
+
+/**
+  \fn          uint32_t SensorDecim_ProcessS16 (SensorDecim_t *decim, const int16_t *src, int16_t *dst, uint32_t frames)
+  \brief       Decimate int16 (Q15) frames into Q15 frames.
+  \param[in]   decim        decimator instance
+  \param[in]   src          interleaved input frames
+  \param[out]  dst          interleaved output frames
+  \param[in]   frames       number of input frames (up to block_frames)
+  \return      number of output frames
+*/
+uint32_t SensorDecim_ProcessS16 (SensorDecim_t *decim, const int16_t *src, int16_t *dst, uint32_t frames);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_DECIM_H */
@@ -6,29 +6,74 @@
 
 #include "sensor_drv.h"
 #include "arm_vsi.h"
-#include "platform_irq.h"
+#include "vsi_stream.h"
+#include "sensor_regs.h"
 #ifdef _RTE_
 #include "RTE_Components.h"
 #endif
 #include CMSIS_device_header
+#include "cmsis_os2.h"
 
 /* Sensor Peripheral definitions */
-#define SensorO          ARM_VSI1_NS                /* Sensor Output access struct */
-#define SensorO_IRQn     ARM_VSI1_IRQn           /* Sensor Output Interrupt number */
-#define SensorO_Handler  ARM_VSI1_Handler        /* Sensor Output Interrupt handler */
-#define SensorI          ARM_VSI0_NS                /* Sensor Input access struct */
-#define SensorI_IRQn     ARM_VSI0_IRQn           /* Sensor Input Interrupt number */
-#define SensorI_Handler  ARM_VSI0_Handler        /* Sensor Input Interrupt handler */
-
-/* Sensor Peripheral registers */
-#define CONTROL         Regs[0] /* Control receiver */
-#define CHANNELS        Regs[1] /* Number of channels */
-#define SAMPLE_BITS     Regs[2] /* Sample number of bits (8..32) */
-#define SAMPLE_RATE     Regs[3] /* Sample rate (samples per second) */
-
-/* Sensor Control register definitions */
-#define CONTROL_ENABLE_Pos      0U                              /* CONTROL: ENABLE Position */
-#define CONTROL_ENABLE_Msk      (1UL << CONTROL_ENABLE_Pos)     /* CONTROL: ENABLE Mask */
+#ifndef SENSOR_DRV_TX_VSI
+#define SENSOR_DRV_TX_VSI       1U                      /* Sensor Output VSI instance */
+#endif
+#ifndef SENSOR_DRV_RX_VSI
+#define SENSOR_DRV_RX_VSI       0U                      /* Sensor Input VSI instance */
+#endif
+#ifndef SENSOR_DRV_RX_CONSUMERS
+#define SENSOR_DRV_RX_CONSUMERS 4U                      /* Maximum number of Sensor Input block consumers */
+#endif
+
+/* Sensor streams */
+static VSI_Stream_t SensorO;                            /* Sensor Output stream */
+static VSI_Stream_t SensorI;                            /* Sensor Input stream */
+
+/* Sensor Input block consumer */
+typedef struct {
+  osMessageQueueId_t mq_id;                             /* Block sequence number queue */
+  uint32_t           next;                              /* Next block sequence number to be released */
+  uint32_t           lag_max;                           /* Maximum lag at release */
+  volatile uint32_t  dropped;                           /* Notifications lost (queue full) */
+  uint32_t           overwritten;                       /* Blocks overwritten before access */
+} Sensor_Consumer_t;
+
+static Sensor_Consumer_t RxConsumer[SENSOR_DRV_RX_CONSUMERS];
+static volatile uint32_t RxConsumers = 0U;
+
+/* Sensor Input block wait */
+#define RX_EVENT_BLOCKS         (1UL << 0)              /* Requested number of blocks available */
+
+static osEventFlagsId_t  RxEvent     = NULL;
+static volatile uint32_t RxWaitCount = 0U;              /* Blocks requested by waiting thread (0 = none) */
+static volatile uint32_t RxFetchLeft = 0U;              /* Blocks left before auto-pause (0 = disabled) */
+
+/* Sensor Input free-running mode */
+static volatile uint32_t RxFreeRun   = 0U;              /* Free-running mode active */
+static volatile uint32_t RxArmed     = 0U;              /* Single block transfer in progress */
+
+/* Sensor Input timestamped replay (block intervals taken from the capture) */
+static volatile uint32_t RxReplay    = 0U;
+
+/* Lost block accounting */
+static volatile uint32_t RxOverflow  = 0U;              /* Received blocks lapped by DMA (or by decimation) */
+static uint32_t          RxUnderflowBase = 0U;          /* Peripheral UNDERFLOW at initialization */
+static uint32_t          TxOverflowBase  = 0U;          /* Peripheral OVERFLOW at initialization */
+
+/* Sensor Input decimation stage */
+typedef struct {
+  SensorDecim_t     *decim;                             /* Decimator (NULL = stage not used) */
+  uint8_t           *buf;                               /* Decimated block ring start address */
+  uint32_t           block_num;                         /* Number of blocks in ring (2^n) */
+  uint32_t           block_size;                        /* Block size in bytes */
+  uint32_t           block_frames;                      /* Output frames per block */
+  uint32_t           fill;                              /* Frames in the block being filled */
+  volatile uint32_t  block_in;                          /* Producer index: blocks completed */
+  volatile uint32_t  block_out;                         /* Consumer index: blocks released */
+  volatile uint32_t  overrun;                           /* Overrun flag (ring lapped unreleased blocks) */
+} Sensor_Decim_t;
+
+static Sensor_Decim_t RxDecim;
 
 /* Driver State */
 static uint8_t Initialized = 0U;
@@ -36,25 +81,202 @@ static uint8_t Initialized = 0U;
 /* Event Callback */
 static SensorDrv_Event_t CB_Event = NULL;
 
-/* Sensor Output Interrupt Handler */
-void SensorO_Handler (void) {
+static uint32_t Sensor_BlockFrames (VSI_Stream_t *stream);
+
+/* Number of received blocks not yet released by the slowest block consumer */
+static uint32_t Sensor_RxConsumerLag (void) {
+  uint32_t lag_max = 0U;
+  uint32_t lag;
+  uint32_t n;
+
+  for (n = 0U; n < RxConsumers; n++) {
+    lag = SensorI.block_in - RxConsumer[n].next;
+    if (lag > lag_max) {
+      lag_max = lag;
+    }
+  }
+
+  return lag_max;
+}
+
+/* Number of received blocks not yet released (decimated blocks when the stage is set) */
+static uint32_t Sensor_RxPending (void) {
+  if (RxDecim.decim != NULL) {
+    return (RxDecim.block_in - RxDecim.block_out);
+  }
+  return (SensorI.block_in - SensorI.block_out);
+}
+
+/* Number of blocks in the ring the application consumes from */
+static uint32_t Sensor_RxBlockNum (void) {
+  if (RxDecim.decim != NULL) {
+    return (RxDecim.block_num);
+  }
+  return (SensorI.block_num);
+}
+
+/* Free-running mode: transfer the next block right away while the ring has room
+   (with block consumers, room is left by the slowest consumer) */
+static void Sensor_FreeRun (void) {
+  uint32_t pending;
+
+  pending = (RxConsumers != 0U) ? Sensor_RxConsumerLag() : Sensor_RxPending();
+  if ((RxFreeRun != 0U) && (RxArmed == 0U) &&
+      ((SensorI.vsi->DMA.Control & ARM_VSI_DMA_Enable_Msk) != 0U) &&
+      (pending < Sensor_RxBlockNum())) {
+    RxArmed = 1U;
+    VSI_Stream_Trigger(&SensorI);
+  }
+}
+
+/* Decimate the last received DMA block into the decimated block ring */
+static uint32_t Sensor_Decimate (VSI_Stream_t *stream) {
+  SensorDecim_t *decim = RxDecim.decim;
+  const uint8_t *src;
+  int16_t       *dst;
+  uint32_t       sample_size;
+  uint32_t       frames;
+  uint32_t       chunk;
+  uint32_t       event = 0U;
+
+  sample_size = (stream->vsi->SAMPLE_BITS + 7U) / 8U;
+  frames      = Sensor_BlockFrames(stream);
+  src         = stream->buf + (((stream->block_in - 1U) & (stream->block_num - 1U)) * stream->block_size);
+
+  /* DMA block is consumed here, the application only sees decimated blocks */
+  stream->block_out = stream->block_in;
+
+  while (frames != 0U) {
+    /* Largest input chunk whose outputs still fit into the current decimated block */
+    chunk = decim->phase + ((RxDecim.block_frames - RxDecim.fill - 1U) * decim->factor) + 1U;
+    if (chunk > frames) {
+      chunk = frames;
+    }
+
+    dst = (int16_t *)(RxDecim.buf + ((RxDecim.block_in & (RxDecim.block_num - 1U)) * RxDecim.block_size));
+    dst = &dst[RxDecim.fill * decim->channels];
+    if (sample_size == 1U) {
+      RxDecim.fill += SensorDecim_ProcessS8(decim, (const int8_t *)src, dst, chunk);
+    } else {
+      RxDecim.fill += SensorDecim_ProcessS16(decim, (const int16_t *)src, dst, chunk);
+    }
+    src    += chunk * decim->channels * sample_size;
+    frames -= chunk;
+
+    if (RxDecim.fill == RxDecim.block_frames) {
+      RxDecim.fill = 0U;
+      RxDecim.block_in++;
+      event |= SENSOR_DRV_EVENT_RX_DATA;
+
+      /* Overflow: the completed block has overwritten the oldest unreleased one */
+      if ((RxDecim.block_in - RxDecim.block_out) > RxDecim.block_num) {
+        RxOverflow++;
+        event |= SENSOR_DRV_EVENT_RX_OVERFLOW;
+      }
+    }
+  }
+
+  return event;
+}
+
+/* Sensor stream interrupt callback */
+static void Sensor_Event (VSI_Stream_t *stream, uint32_t irq_status) {
+  uint32_t event = 0U;
+  uint32_t seq;
+  uint32_t n;
 
-  SensorO->IRQ.Clear = 0x00000001U;
-  __DSB();
-  __ISB();
-  if (CB_Event != NULL) {
-    CB_Event(SENSOR_DRV_EVENT_TX_DATA);
+  if (stream == &SensorI) {
+    if ((irq_status & IRQ_Status_UNDERFLOW_Msk) != 0U) {
+      event |= SENSOR_DRV_EVENT_RX_UNDERFLOW;
+    }
+    if ((irq_status & IRQ_Status_DATA_Msk) != 0U) {
+      RxArmed = 0U;
+      if (RxDecim.decim != NULL) {
+        event |= Sensor_Decimate(stream);
+      } else {
+        event |= SENSOR_DRV_EVENT_RX_DATA;
+
+        /* Overflow: the new block has overwritten the oldest unreleased one
+           (with block consumers, the oldest one not released by the slowest consumer) */
+        n = (RxConsumers != 0U) ? Sensor_RxConsumerLag() : (stream->block_in - stream->block_out);
+        if (n > stream->block_num) {
+          RxOverflow++;
+          event |= SENSOR_DRV_EVENT_RX_OVERFLOW;
+        }
+      }
+
+      /* Publish sequence number of the completed block to all consumers */
+      seq = stream->block_in - 1U;
+      for (n = 0U; n < RxConsumers; n++) {
+        if (osMessageQueuePut(RxConsumer[n].mq_id, &seq, 0U, 0U) != osOK) {
+          RxConsumer[n].dropped++;
+        }
+      }
+
+      /* One-shot fetch: pause after the requested number of blocks */
+      if (RxFetchLeft != 0U) {
+        RxFetchLeft--;
+        if (RxFetchLeft == 0U) {
+          VSI_Stream_Stop(stream);
+        }
+      }
+
+      /* Wake thread waiting in SensorDrv_WaitRx */
+      n = RxWaitCount;
+      if ((n != 0U) && (Sensor_RxPending() >= n)) {
+        RxWaitCount = 0U;
+        osEventFlagsSet(RxEvent, RX_EVENT_BLOCKS);
+      }
+
+      Sensor_FreeRun();
+
+      /* Timestamped replay: pace the next block at the recorded interval */
+      if (RxReplay != 0U) {
+        n = stream->vsi->INTERVAL;
+        if ((n != 0U) && (n != stream->interval)) {
+          VSI_Stream_SetInterval(stream, n);
+        }
+      }
+    }
+  } else {
+    if ((irq_status & IRQ_Status_DATA_Msk) != 0U) {
+      event |= SENSOR_DRV_EVENT_TX_DATA;
+    }
+    if ((irq_status & IRQ_Status_OVERFLOW_Msk) != 0U) {
+      event |= SENSOR_DRV_EVENT_TX_OVERFLOW;
+    }
+  }
+
+  if ((CB_Event != NULL) && (event != 0U)) {
+    CB_Event(event);
   }
 }
 
-/* Sensor Input Interrupt Handler */
-void SensorI_Handler (void) {
+/* Get number of frames (samples of all channels) in a stream block */
+static uint32_t Sensor_BlockFrames (VSI_Stream_t *stream) {
+  ARM_VSI_Type *vsi = stream->vsi;
+  uint32_t sample_size;
 
-  SensorI->IRQ.Clear = 0x00000001U;
-  __DSB();
-  __ISB();
-  if (CB_Event != NULL) {
-    CB_Event(SENSOR_DRV_EVENT_RX_DATA);
+  sample_size = vsi->CHANNELS * ((vsi->SAMPLE_BITS + 7U) / 8U);
+  if (sample_size == 0U) {
+    return 0U;
+  }
+
+  return (stream->block_size / sample_size);
+}
+
+/* Set stream block period from sensor configuration
+   (block period = 1000000 * frames / sample_rate microseconds) */
+static void Sensor_SetInterval (VSI_Stream_t *stream, uint32_t fractional) {
+  uint32_t frames;
+  uint32_t sample_rate;
+
+  frames      = Sensor_BlockFrames(stream);
+  sample_rate = stream->vsi->SAMPLE_RATE;
+  if ((frames == 0U) || (sample_rate == 0U)) {
+    VSI_Stream_SetInterval(stream, 0xFFFFFFFFU);
+  } else {
+    VSI_Stream_SetPeriod(stream, 1000000ULL * frames, sample_rate, fractional);
   }
 }
 
@@ -63,29 +285,34 @@ int32_t SensorDrv_Initialize (SensorDrv_Event_t cb_event) {
 
   CB_Event = cb_event;
 
+  if (RxEvent == NULL) {
+    RxEvent = osEventFlagsNew(NULL);
+    if (RxEvent == NULL) {
+      return SENSOR_DRV_ERROR;
+    }
+  }
+  RxWaitCount = 0U;
+  RxFetchLeft = 0U;
+  RxFreeRun   = 0U;
+  RxArmed     = 0U;
+  RxReplay    = 0U;
+  RxOverflow  = 0U;
+  RxDecim.decim = NULL;
+
   /* Initialize Sensor Output peripheral */
-  SensorO->Timer.Control = 0U;
-  SensorO->DMA.Control   = 0U;
-  SensorO->IRQ.Clear     = 0x00000001U;
-  SensorO->IRQ.Enable    = 0x00000001U;
-  SensorO->CONTROL       = 0U;
+  if (VSI_Stream_Bind(&SensorO, SENSOR_DRV_TX_VSI, IRQ_Status_Msk, Sensor_Event, NULL) != VSI_STREAM_OK) {
+    return SENSOR_DRV_ERROR;
+  }
+  SensorO.vsi->CONTROL = 0U;
+  TxOverflowBase = SensorO.vsi->OVERFLOW;
 
   /* Initialize Sensor Input peripheral */
-  SensorI->Timer.Control = 0U;
-  SensorI->DMA.Control   = 0U;
-  SensorI->IRQ.Clear     = 0x00000001U;
-  SensorI->IRQ.Enable    = 0x00000001U;
-  SensorI->CONTROL       = 0U;
-
-  /* Enable peripheral interrupts */
-  NVIC_EnableIRQ(SensorO_IRQn);
-  //NVIC->ISER[(((uint32_t)SensorO_IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)SensorO_IRQn) & 0x1FUL));
-
-  NVIC_EnableIRQ(SensorI_IRQn);
-//  NVIC->ISER[(((uint32_t)SensorI_IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)SensorI_IRQn) & 0x1FUL));
-
-  __DSB();
-  __ISB();
+  if (VSI_Stream_Bind(&SensorI, SENSOR_DRV_RX_VSI, IRQ_Status_Msk, Sensor_Event, NULL) != VSI_STREAM_OK) {
+    VSI_Stream_Unbind(&SensorO);
+    return SENSOR_DRV_ERROR;
+  }
+  SensorI.vsi->CONTROL = 0U;
+  RxUnderflowBase = SensorI.vsi->UNDERFLOW;
 
   Initialized = 1U;
 
@@ -95,28 +322,19 @@ int32_t SensorDrv_Initialize (SensorDrv_Event_t cb_event) {
 /* De-initialize Sensor Interface */
 int32_t SensorDrv_Uninitialize (void) {
 
-  /* Disable peripheral interrupts */
-NVIC_DisableIRQ(SensorO_IRQn);
-//  NVIC->ICER[(((uint32_t)SensorO_IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)SensorO_IRQn) & 0x1FUL));
-
-NVIC_DisableIRQ(SensorI_IRQn);
-//  NVIC->ICER[(((uint32_t)SensorI_IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)SensorI_IRQn) & 0x1FUL));
-  __DSB();
-  __ISB();
+  if (Initialized == 0U) {
+    return SENSOR_DRV_OK;
+  }
 
   /* De-initialize Sensor Output peripheral */
-  SensorO->Timer.Control = 0U;
-  SensorO->DMA.Control   = 0U;
-  SensorO->IRQ.Clear     = 0x00000001U;
-  SensorO->IRQ.Enable    = 0x00000000U;
-  SensorO->CONTROL       = 0U;
+  VSI_Stream_Unbind(&SensorO);
+  SensorO.vsi->CONTROL = 0U;
 
   /* De-initialize Sensor Input peripheral */
-  SensorI->Timer.Control = 0U;
-  SensorI->DMA.Control   = 0U;
-  SensorI->IRQ.Clear     = 0x00000001U;
-  SensorI->IRQ.Enable    = 0x00000000U;
-  SensorI->CONTROL       = 0U;
+  VSI_Stream_Unbind(&SensorI);
+  SensorI.vsi->CONTROL = 0U;
+
+  RxConsumers = 0U;
 
   Initialized = 0U;
 
@@ -125,7 +343,7 @@ NVIC_DisableIRQ(SensorI_IRQn);
 
 /* Configure Sensor Interface */
 int32_t SensorDrv_Configure (uint32_t interface, uint32_t channels, uint32_t sample_bits, uint32_t sample_rate) {
-  uint32_t format;
+  VSI_Stream_t *stream;
 
   if (Initialized == 0U) {
     return SENSOR_DRV_ERROR;
@@ -141,30 +359,29 @@ int32_t SensorDrv_Configure (uint32_t interface, uint32_t channels, uint32_t sam
 
   switch (interface) {
     case SENSOR_DRV_INTERFACE_TX:
-      if ((SensorO->CONTROL & CONTROL_ENABLE_Msk) != 0U) {
-        return SENSOR_DRV_ERROR;
-      }
-      SensorO->CHANNELS    = channels;
-      SensorO->SAMPLE_BITS = sample_bits;
-      SensorO->SAMPLE_RATE = sample_rate;
+      stream = &SensorO;
       break;
     case SENSOR_DRV_INTERFACE_RX:
-      if ((SensorI->CONTROL & CONTROL_ENABLE_Msk) != 0U) {
-        return SENSOR_DRV_ERROR;
-      }
-      SensorI->CHANNELS    = channels;
-      SensorI->SAMPLE_BITS = sample_bits;
-      SensorI->SAMPLE_RATE = sample_rate;
+      stream = &SensorI;
       break;
     default:
       return SENSOR_DRV_ERROR_PARAMETER;
   }
 
+  if ((stream->vsi->CONTROL & CONTROL_ENABLE_Msk) != 0U) {
+    return SENSOR_DRV_ERROR;
+  }
+  stream->vsi->CHANNELS    = channels;
+  stream->vsi->SAMPLE_BITS = sample_bits;
+  stream->vsi->SAMPLE_RATE = sample_rate;
+
   return SENSOR_DRV_OK;
 }
 
 /* Set Sensor Interface buffer */
 int32_t SensorDrv_SetBuf (uint32_t interface, void *buf, uint32_t block_num, uint32_t block_size) {
+  VSI_Stream_t *stream;
+  int32_t       status;
 
   if (Initialized == 0U) {
     return SENSOR_DRV_ERROR;
@@ -172,98 +389,113 @@ int32_t SensorDrv_SetBuf (uint32_t interface, void *buf, uint32_t block_num, uin
 
   switch (interface) {
     case SENSOR_DRV_INTERFACE_TX:
-      if ((SensorO->DMA.Control & ARM_VSI_DMA_Enable_Msk) != 0U) {
-        return SENSOR_DRV_ERROR;
-      }
-      SensorO->DMA.Address   = (uint32_t)buf;
-      SensorO->DMA.BlockNum  = block_num;
-      SensorO->DMA.BlockSize = block_size;
+      stream = &SensorO;
       break;
     case SENSOR_DRV_INTERFACE_RX:
-      if ((SensorI->DMA.Control & ARM_VSI_DMA_Enable_Msk) != 0U) {
-        return SENSOR_DRV_ERROR;
-      }
-      SensorI->DMA.Address   = (uint32_t)buf;
-      SensorI->DMA.BlockNum  = block_num;
-      SensorI->DMA.BlockSize = block_size;
+      stream = &SensorI;
       break;
     default:
       return SENSOR_DRV_ERROR_PARAMETER;
   }
 
+  status = VSI_Stream_SetBuf(stream, buf, block_num, block_size);
+  if (status == VSI_STREAM_ERROR_PARAMETER) {
+    return SENSOR_DRV_ERROR_PARAMETER;
+  }
+  if (status != VSI_STREAM_OK) {
+    return SENSOR_DRV_ERROR;
+  }
+
   return SENSOR_DRV_OK;
 }
 
-uint32_t irq, tm_ctrl, dma_ctrl;
-
-
 /* Control Sensor Interface */
 int32_t SensorDrv_Control (uint32_t control) {
-  uint32_t sample_size;
-  uint32_t sample_rate;
-  uint32_t block_size;
+  uint32_t block_in;
+  uint32_t dropped;
 
   if (Initialized == 0U) {
     return SENSOR_DRV_ERROR;
   }
 
   if ((control & SENSOR_DRV_CONTROL_TX_DISABLE) != 0U) {
-    SensorO->Timer.Control = 0U;
-    SensorO->DMA.Control   = 0U;
-    SensorO->CONTROL       = 0U;
+    VSI_Stream_Stop(&SensorO);
+    SensorO.vsi->CONTROL = 0U;
   } else if ((control & SENSOR_DRV_CONTROL_TX_ENABLE) != 0U) {
-    SensorO->CONTROL       = CONTROL_ENABLE_Msk;
-    SensorO->DMA.Control   = ARM_VSI_DMA_Direction_M2P |
-                            ARM_VSI_DMA_Enable_Msk;
-    sample_size = SensorO->CHANNELS * ((SensorO->SAMPLE_BITS + 7U) / 8U);
-    sample_rate = SensorO->SAMPLE_RATE;
-    if ((sample_size == 0U) || (sample_rate == 0U)) {
-      SensorO->Timer.Interval = 0xFFFFFFFFU;
-    } else {
-      block_size = SensorO->DMA.BlockSize;
-      SensorO->Timer.Interval = (1000000U * (block_size / sample_size)) / sample_rate;
-    }
-    SensorO->Timer.Control = ARM_VSI_Timer_Trig_DMA_Msk |
-                             ARM_VSI_Timer_Trig_IRQ_Msk |
-                             ARM_VSI_Timer_Periodic_Msk |
-                             ARM_VSI_Timer_Run_Msk;
+    SensorO.vsi->CONTROL = CONTROL_ENABLE_Msk;
+    Sensor_SetInterval(&SensorO, ((control & SENSOR_DRV_CONTROL_HIGH_RATE) != 0U) ? 1U : 0U);
+    VSI_Stream_Start(&SensorO, VSI_STREAM_OUTPUT, VSI_STREAM_PERIODIC);
   }
 
   if ((control & SENSOR_DRV_CONTROL_RX_DISABLE) != 0U) {
-    SensorI->Timer.Control = 0U;
-    SensorI->DMA.Control   = 0U;
-    SensorI->CONTROL       = 0U;
+    VSI_Stream_Stop(&SensorI);
+    SensorI.vsi->CONTROL = 0U;
+    RxFreeRun = 0U;
+    RxArmed   = 0U;
+    RxReplay  = 0U;
   } else if ((control & SENSOR_DRV_CONTROL_RX_ENABLE) != 0U) {
-    SensorI->CONTROL       = CONTROL_ENABLE_Msk;
-    SensorI->DMA.Control   = ARM_VSI_DMA_Direction_P2M |
-                            ARM_VSI_DMA_Enable_Msk;
-    sample_size = SensorI->CHANNELS * ((SensorI->SAMPLE_BITS + 7U) / 8U);
-    sample_rate = SensorI->SAMPLE_RATE;
-    if ((sample_size == 0U) || (sample_rate == 0U)) {
-      SensorI->Timer.Interval = 0xFFFFFFFFU;
+    SensorI.overrun = 0U;
+    if ((control & SENSOR_DRV_CONTROL_RX_FREE_RUN) != 0U) {
+      /* Blocks are requested one at a time, 1 us after the ring has room */
+      SensorI.vsi->CONTROL = CONTROL_ENABLE_Msk | CONTROL_FREE_RUN_Msk;
+      VSI_Stream_SetInterval(&SensorI, 1U);
+      RxFreeRun = 1U;
     } else {
-      block_size = SensorI->DMA.BlockSize;
-      SensorI->Timer.Interval = (1000000U * (block_size / sample_size)) / sample_rate;
+      SensorI.vsi->CONTROL = CONTROL_ENABLE_Msk;
+      Sensor_SetInterval(&SensorI, ((control & SENSOR_DRV_CONTROL_HIGH_RATE) != 0U) ? 1U : 0U);
+      RxFreeRun = 0U;
+    }
+    /* Sensor data file is open now: a timestamped capture reports the first interval */
+    RxReplay = ((RxFreeRun == 0U) && (SensorI.vsi->INTERVAL != 0U)) ? 1U : 0U;
+    if (RxDecim.decim != NULL) {
+      SensorDecim_Reset(RxDecim.decim);
+      RxDecim.fill      = 0U;
+      RxDecim.block_in  = 0U;
+      RxDecim.block_out = 0U;
+      RxDecim.overrun   = 0U;
+    }
+    RxArmed = RxFreeRun;
+    VSI_Stream_Start(&SensorI, VSI_STREAM_INPUT, (RxFreeRun != 0U) ? VSI_STREAM_SINGLE : VSI_STREAM_PERIODIC);
+    /* New stream: blocks of a previous stream are not delivered */
+    SensorI.block_out = SensorI.block_in;
+    for (uint32_t n = 0U; n < RxConsumers; n++) {
+      RxConsumer[n].next = SensorI.block_in;
     }
-    SensorI->Timer.Control = ARM_VSI_Timer_Trig_DMA_Msk |
-                             ARM_VSI_Timer_Trig_IRQ_Msk |
-                             ARM_VSI_Timer_Periodic_Msk |
-                             ARM_VSI_Timer_Run_Msk;
   }
 
   if((control & SENSOR_DRV_CONTROL_RX_PAUSE) != 0U) {
-    SensorI->IRQ.Enable    = 0x00000000U;
-    SensorI->Timer.Control = 0U;
-    SensorI->DMA.Control   = 0U;
+    SensorI.vsi->IRQ.Enable = 0x00000000U;
+    VSI_Stream_Stop(&SensorI);
+    RxFetchLeft = 0U;
+    RxArmed     = 0U;
   }
-  else if((control & SENSOR_DRV_CONTROL_RX_RESUME) != 0U) {
-    SensorI->IRQ.Enable    = 0x00000001U;
-    SensorI->Timer.Control = ARM_VSI_Timer_Trig_DMA_Msk |
-                             ARM_VSI_Timer_Trig_IRQ_Msk |
-                             ARM_VSI_Timer_Periodic_Msk |
-                             ARM_VSI_Timer_Run_Msk;
-    SensorI->DMA.Control   = ARM_VSI_DMA_Direction_P2M |
-                             ARM_VSI_DMA_Enable_Msk;
+  else if((control & (SENSOR_DRV_CONTROL_RX_RESUME | SENSOR_DRV_CONTROL_RX_FETCH)) != 0U) {
+    if ((control & SENSOR_DRV_CONTROL_RX_FETCH) != 0U) {
+      RxFetchLeft = (control >> 16) & 0xFFFFU;
+      if (RxFetchLeft == 0U) {
+        return SENSOR_DRV_ERROR_PARAMETER;
+      }
+    } else {
+      RxFetchLeft = 0U;
+    }
+    SensorI.vsi->IRQ.Enable = IRQ_Status_Msk;
+    RxArmed = RxFreeRun;
+    block_in = SensorI.block_in;
+    dropped  = VSI_Stream_Start(&SensorI, VSI_STREAM_INPUT, (RxFreeRun != 0U) ? VSI_STREAM_SINGLE : VSI_STREAM_PERIODIC);
+    if (dropped != 0U) {
+      /* Unreleased blocks lost on restart are counted and signalled like an overflow */
+      RxOverflow     += dropped;
+      SensorI.overrun = 1U;
+      if (CB_Event != NULL) {
+        CB_Event(SENSOR_DRV_EVENT_RX_OVERFLOW);
+      }
+    }
+    /* Consumers that released all blocks continue at the block the DMA transfers next */
+    for (uint32_t n = 0U; n < RxConsumers; n++) {
+      if (RxConsumer[n].next == block_in) {
+        RxConsumer[n].next = SensorI.block_in;
+      }
+    }
   }
 
   return SENSOR_DRV_OK;
@@ -271,30 +503,323 @@ int32_t SensorDrv_Control (uint32_t control) {
 
 /* Get transmitted block count */
 uint32_t SensorDrv_GetTxCount (void) {
-  return (SensorO->Timer.Count);
+  return (VSI_Stream_GetCount(&SensorO));
 }
 
 /* Get received block count */
 uint32_t SensorDrv_GetRxCount (void) {
-  return (SensorI->Timer.Count);
+  return (VSI_Stream_GetCount(&SensorI));
+}
+
+/* Get effective sample rate */
+uint32_t SensorDrv_GetRate (uint32_t interface) {
+  VSI_Stream_t *stream;
+  uint64_t      num;
+  uint32_t      den;
+
+  if (Initialized == 0U) {
+    return 0U;
+  }
+
+  switch (interface) {
+    case SENSOR_DRV_INTERFACE_TX:
+      stream = &SensorO;
+      break;
+    case SENSOR_DRV_INTERFACE_RX:
+      stream = &SensorI;
+      break;
+    default:
+      return 0U;
+  }
+
+  VSI_Stream_GetPeriod(stream, &num, &den);
+  if (num == 0U) {
+    return 0U;
+  }
+
+  /* rate = frames / (num / den) microseconds, rounded */
+  return ((uint32_t)((((uint64_t)Sensor_BlockFrames(stream) * 1000000U * den) + (num / 2U)) / num));
+}
+
+/* Get oldest received block not yet released */
+void *SensorDrv_GetRxBlock (void) {
+  uint32_t in, out;
+
+  if (Initialized == 0U) {
+    return NULL;
+  }
+
+  if (RxDecim.decim == NULL) {
+    return (VSI_Stream_GetBlock(&SensorI));
+  }
+
+  in  = RxDecim.block_in;
+  out = RxDecim.block_out;
+
+  if ((in - out) > RxDecim.block_num) {
+    /* Decimation has wrapped over unreleased blocks: skip to the oldest intact one */
+    out               = in - RxDecim.block_num;
+    RxDecim.block_out = out;
+    RxDecim.overrun   = 1U;
+  }
+
+  if (in == out) {
+    return NULL;
+  }
+
+  return (RxDecim.buf + ((out & (RxDecim.block_num - 1U)) * RxDecim.block_size));
+}
+
+/* Release received block */
+int32_t SensorDrv_ReleaseRxBlock (void) {
+
+  if (Initialized == 0U) {
+    return SENSOR_DRV_ERROR;
+  }
+
+  if (RxDecim.decim != NULL) {
+    if (RxDecim.block_in == RxDecim.block_out) {
+      return SENSOR_DRV_ERROR;
+    }
+    RxDecim.block_out++;
+    Sensor_FreeRun();
+    return SENSOR_DRV_OK;
+  }
+
+  if (VSI_Stream_ReleaseBlock(&SensorI) != VSI_STREAM_OK) {
+    return SENSOR_DRV_ERROR;
+  }
+  Sensor_FreeRun();
+
+  return SENSOR_DRV_OK;
+}
+
+/* Wait until received blocks are available */
+int32_t SensorDrv_WaitRx (uint32_t count, uint32_t timeout) {
+  uint32_t flags;
+
+  if (Initialized == 0U) {
+    return SENSOR_DRV_ERROR;
+  }
+
+  if ((count == 0U) || (count > ((RxDecim.decim != NULL) ? RxDecim.block_num : SensorI.block_num))) {
+    return SENSOR_DRV_ERROR_PARAMETER;
+  }
+
+  osEventFlagsClear(RxEvent, RX_EVENT_BLOCKS);
+
+  /* Publish request before checking, so that a block completing in between wakes the thread */
+  RxWaitCount = count;
+  __DMB();
+  if (Sensor_RxPending() >= count) {
+    RxWaitCount = 0U;
+    return SENSOR_DRV_OK;
+  }
+
+  flags = osEventFlagsWait(RxEvent, RX_EVENT_BLOCKS, osFlagsWaitAny, timeout);
+  RxWaitCount = 0U;
+
+  if ((flags & osFlagsError) != 0U) {
+    if (Sensor_RxPending() >= count) {
+      return SENSOR_DRV_OK;
+    }
+    return SENSOR_DRV_ERROR_TIMEOUT;
+  }
+
+  return SENSOR_DRV_OK;
+}
+
+/* Set Receiver decimation stage */
+int32_t SensorDrv_SetRxDecimator (SensorDecim_t *decim, void *buf, uint32_t block_num, uint32_t block_size) {
+  uint32_t frame_size;
+
+  if (Initialized == 0U) {
+    return SENSOR_DRV_ERROR;
+  }
+
+  if ((SensorI.vsi->CONTROL & CONTROL_ENABLE_Msk) != 0U) {
+    return SENSOR_DRV_ERROR_BUSY;
+  }
+
+  if (decim == NULL) {
+    RxDecim.decim = NULL;
+    return SENSOR_DRV_OK;
+  }
+
+  /* Block consumers access DMA blocks, which the decimation stage consumes */
+  if (RxConsumers != 0U) {
+    return SENSOR_DRV_ERROR_BUSY;
+  }
+
+  if ((buf == NULL) ||
+      (block_num == 0U) ||
+      ((block_num & (block_num - 1U)) != 0U) ||
+      (decim->channels != SensorI.vsi->CHANNELS) ||
+      (SensorI.vsi->SAMPLE_BITS > 16U) ||
+      (decim->block_frames < Sensor_BlockFrames(&SensorI))) {
+    return SENSOR_DRV_ERROR_PARAMETER;
+  }
+
+  frame_size = decim->channels * sizeof(int16_t);
+  if ((block_size < frame_size) || ((block_size % frame_size) != 0U)) {
+    return SENSOR_DRV_ERROR_PARAMETER;
+  }
+
+  RxDecim.buf          = (uint8_t *)buf;
+  RxDecim.block_num    = block_num;
+  RxDecim.block_size   = block_size;
+  RxDecim.block_frames = block_size / frame_size;
+  RxDecim.fill         = 0U;
+  RxDecim.block_in     = 0U;
+  RxDecim.block_out    = 0U;
+  RxDecim.overrun      = 0U;
+  RxDecim.decim        = decim;
+
+  return SENSOR_DRV_OK;
+}
+
+/* Add Receiver block consumer */
+int32_t SensorDrv_AddRxConsumer (void *mq_id) {
+  Sensor_Consumer_t *consumer;
+  uint32_t n;
+
+  if (Initialized == 0U) {
+    return SENSOR_DRV_ERROR;
+  }
+
+  if (mq_id == NULL) {
+    return SENSOR_DRV_ERROR_PARAMETER;
+  }
+
+  n = RxConsumers;
+  if ((n >= SENSOR_DRV_RX_CONSUMERS) || (RxDecim.decim != NULL)) {
+    return SENSOR_DRV_ERROR_BUSY;
+  }
+
+  consumer = &RxConsumer[n];
+  consumer->mq_id       = (osMessageQueueId_t)mq_id;
+  consumer->next        = SensorI.block_in;
+  consumer->lag_max     = 0U;
+  consumer->dropped     = 0U;
+  consumer->overwritten = 0U;
+
+  /* Consumer becomes visible to the interrupt only when fully set up */
+  __DMB();
+  RxConsumers = n + 1U;
+
+  return ((int32_t)n);
+}
+
+/* Get received block by sequence number */
+void *SensorDrv_GetRxBlockSeq (uint32_t consumer, uint32_t seq) {
+  uint32_t lag;
+
+  if ((consumer >= RxConsumers) || (SensorI.buf == NULL)) {
+    return NULL;
+  }
+
+  /* Valid blocks: seq in [block_in - block_num, block_in - 1] */
+  lag = SensorI.block_in - seq;
+  if (lag == 0U) {
+    /* Not received yet */
+    return NULL;
+  }
+  if (lag > SensorI.block_num) {
+    /* Overwritten: the block needs no release, the consumer moves past it */
+    RxConsumer[consumer].overwritten++;
+    RxConsumer[consumer].next = seq + 1U;
+    return NULL;
+  }
+
+  return (SensorI.buf + ((seq & (SensorI.block_num - 1U)) * SensorI.block_size));
+}
+
+/* Release received block by sequence number */
+int32_t SensorDrv_ReleaseRxBlockSeq (uint32_t consumer, uint32_t seq) {
+  Sensor_Consumer_t *c;
+  uint32_t lag;
+
+  if (consumer >= RxConsumers) {
+    return SENSOR_DRV_ERROR_PARAMETER;
+  }
+
+  c       = &RxConsumer[consumer];
+  c->next = seq + 1U;
+  lag     = SensorI.block_in - c->next;
+  if (lag > c->lag_max) {
+    c->lag_max = lag;
+  }
+
+  Sensor_FreeRun();
+
+  /* The DMA has overwritten the block while the consumer was processing it */
+  if ((SensorI.block_in - seq) > SensorI.block_num) {
+    c->overwritten++;
+    return SENSOR_DRV_ERROR;
+  }
+
+  return SENSOR_DRV_OK;
+}
+
+/* Get Receiver block consumer statistics */
+int32_t SensorDrv_GetRxConsumerStats (uint32_t consumer, SensorDrv_ConsumerStats_t *stats) {
+  Sensor_Consumer_t *c;
+
+  if ((consumer >= RxConsumers) || (stats == NULL)) {
+    return SENSOR_DRV_ERROR_PARAMETER;
+  }
+
+  c = &RxConsumer[consumer];
+  stats->lag         = SensorI.block_in - c->next;
+  stats->lag_max     = c->lag_max;
+  stats->dropped     = c->dropped;
+  stats->overwritten = c->overwritten;
+
+  return SENSOR_DRV_OK;
+}
+
+/* Get lost block counters */
+int32_t SensorDrv_GetCounters (SensorDrv_Counters_t *counters) {
+
+  if (Initialized == 0U) {
+    return SENSOR_DRV_ERROR;
+  }
+
+  if (counters == NULL) {
+    return SENSOR_DRV_ERROR_PARAMETER;
+  }
+
+  /* Peripheral counters are monotonic: report the increase since initialization */
+  counters->rx_overflow  = RxOverflow;
+  counters->rx_underflow = SensorI.vsi->UNDERFLOW - RxUnderflowBase;
+  counters->tx_overflow  = SensorO.vsi->OVERFLOW  - TxOverflowBase;
+
+  return SENSOR_DRV_OK;
 }
 
 /* Get Sensor Interface status */
 SensorDrv_Status_t SensorDrv_GetStatus (void) {
-  SensorDrv_Status_t status;
-  uint32_t sr;
+  SensorDrv_Status_t status = { 0U, 0U, 0U, 0U };
 
-  if ((SensorO->CONTROL & CONTROL_ENABLE_Msk) != 0U) {
+  if (Initialized == 0U) {
+    return (status);
+  }
+
+  if ((SensorO.vsi->CONTROL & CONTROL_ENABLE_Msk) != 0U) {
     status.tx_active = 1U;
   } else {
     status.tx_active = 0U;
   }
 
-  if ((SensorI->CONTROL & CONTROL_ENABLE_Msk) != 0U) {
+  if ((SensorI.vsi->CONTROL & CONTROL_ENABLE_Msk) != 0U) {
     status.rx_active = 1U;
   } else {
     status.rx_active = 0U;
   }
 
+  status.rx_overrun = SensorI.overrun | RxDecim.overrun;
+  SensorI.overrun = 0U;
+  RxDecim.overrun = 0U;
+
   return (status);
 }
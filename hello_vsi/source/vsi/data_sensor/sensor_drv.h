@@ -12,6 +12,8 @@ extern "C"
 
 #include <stdint.h>
 
+#include "sensor_decim.h"
+
 /* Sensor Interface */
 #define SENSOR_DRV_INTERFACE_TX              (1U)  ///< Transmitter
 #define SENSOR_DRV_INTERFACE_RX              (2U)  ///< Receiver
@@ -27,9 +29,19 @@ extern "C"
 #define SENSOR_DRV_CONTROL_TX_RESUME        (1UL << 6)  ///< Disable Transmitter
 #define SENSOR_DRV_CONTROL_RX_RESUME        (1UL << 7)  ///< Disable Receiver
 
+#define SENSOR_DRV_CONTROL_HIGH_RATE         (1UL << 8)  ///< High-rate mode: fractional interval pacing (with TX/RX_ENABLE)
+
+#define SENSOR_DRV_CONTROL_RX_FETCH          (1UL << 9)  ///< Resume Receiver, pause again after \ref SENSOR_DRV_CONTROL_RX_FETCH_COUNT blocks
+#define SENSOR_DRV_CONTROL_RX_FETCH_COUNT(n) (((uint32_t)(n) & 0xFFFFU) << 16) ///< Number of blocks to fetch (1..65535)
+
+#define SENSOR_DRV_CONTROL_RX_FREE_RUN       (1UL << 10) ///< Free-running mode: unthrottled, next block when ring has room (with RX_ENABLE)
+
 /* Sensor Event */
 #define SENSOR_DRV_EVENT_TX_DATA             (1UL << 0)  ///< Data block transmitted
 #define SENSOR_DRV_EVENT_RX_DATA             (1UL << 1)  ///< Data block received
+#define SENSOR_DRV_EVENT_RX_OVERFLOW         (1UL << 2)  ///< Received block lost (overwritten before it was released)
+#define SENSOR_DRV_EVENT_RX_UNDERFLOW        (1UL << 3)  ///< Received block incomplete (sensor data ran out)
+#define SENSOR_DRV_EVENT_TX_OVERFLOW         (1UL << 4)  ///< Transmitted block lost (sensor output could not keep up)
 
 /* Return code */
 #define SENSOR_DRV_OK                        (0)  ///< Operation succeeded
@@ -45,9 +57,29 @@ extern "C"
 typedef struct {
   uint32_t tx_active        :  1;       ///< Transmitter active
   uint32_t rx_active        :  1;       ///< Receiver active
-  uint32_t reserved         : 30;
+  uint32_t rx_overrun       :  1;       ///< Receiver overrun (cleared on GetStatus)
+  uint32_t reserved         : 29;
 } SensorDrv_Status_t;
 
+/**
+\brief Sensor lost block counters (monotonic, wrap around at 2^32)
+*/
+typedef struct {
+  uint32_t rx_overflow;                 ///< Received blocks overwritten before they were released
+  uint32_t rx_underflow;                ///< Received blocks padded because sensor data ran out
+  uint32_t tx_overflow;                 ///< Transmitted blocks dropped by the sensor output
+} SensorDrv_Counters_t;
+
+/**
+\brief Sensor Receiver block consumer statistics
+*/
+typedef struct {
+  uint32_t lag;                         ///< Blocks received but not yet released by the consumer
+  uint32_t lag_max;                     ///< Maximum lag observed at release
+  uint32_t dropped;                     ///< Block notifications lost (consumer queue full)
+  uint32_t overwritten;                 ///< Blocks overwritten by DMA before the consumer accessed them
+} SensorDrv_ConsumerStats_t;
+
 /**
   \fn          SensorDrv_Event_t
   \brief       Sensor Events callback function type: void (*SensorDrv_Event_t) (uint32_t event
@@ -115,6 +147,102 @@ uint32_t SensorDrv_GetTxCount (void);
 */
 uint32_t SensorDrv_GetRxCount (void);
 
+/**
+  \fn          uint32_t SensorDrv_GetRate (uint32_t interface)
+  \brief       Get effective sample rate resulting from the programmed block interval.
+  \param[in]   interface   sensor interface
+  \return      effective sample rate (samples per second, rounded), 0 if not available
+*/
+uint32_t SensorDrv_GetRate (uint32_t interface);
+
+/**
+  \fn          void *SensorDrv_GetRxBlock (void)
+  \brief       Get oldest received block that is not yet released.
+  \return      pointer to block in the receive buffer, NULL if no block is available
+*/
+void *SensorDrv_GetRxBlock (void);
+
+/**
+  \fn          int32_t SensorDrv_ReleaseRxBlock (void)
+  \brief       Release received block obtained with \ref SensorDrv_GetRxBlock.
+  \return      return code
+*/
+int32_t SensorDrv_ReleaseRxBlock (void);
+
+/**
+  \fn          int32_t SensorDrv_WaitRx (uint32_t count, uint32_t timeout)
+  \brief       Wait until received blocks are available.
+  \details     Blocks the calling thread until at least count received blocks are not yet
+               released (see \ref SensorDrv_GetRxBlock). The thread is woken from the
+               Receiver interrupt, the Receiver registers are not polled.
+  \param[in]   count       number of blocks (1..block_num)
+  \param[in]   timeout     timeout in kernel ticks (osWaitForever to wait indefinitely)
+  \return      return code (\ref SENSOR_DRV_ERROR_TIMEOUT when not enough blocks were received)
+*/
+int32_t SensorDrv_WaitRx (uint32_t count, uint32_t timeout);
+
+/**
+  \fn          int32_t SensorDrv_SetRxDecimator (SensorDecim_t *decim, void *buf, uint32_t block_num, uint32_t block_size)
+  \brief       Set Receiver decimation stage.
+  \details     Every received DMA block is decimated in the receiver interrupt, in place
+               from the DMA buffer, into the ring buf of block_num decimated blocks
+               (interleaved Q15 frames). \ref SensorDrv_GetRxBlock, \ref SensorDrv_ReleaseRxBlock,
+               \ref SensorDrv_WaitRx and \ref SENSOR_DRV_EVENT_RX_DATA then refer to
+               decimated blocks, which complete at the decimated rate. The stage cannot
+               be combined with block consumers (\ref SensorDrv_AddRxConsumer).
+               Call after \ref SensorDrv_Configure while the Receiver is disabled; the
+               decimator is reset on \ref SENSOR_DRV_CONTROL_RX_ENABLE.
+  \param[in]   decim       initialized decimator (channels as configured, block_frames
+                           at least the DMA block frames), NULL to remove the stage
+  \param[in]   buf         pointer to buffer for decimated blocks
+  \param[in]   block_num   number of decimated blocks in buffer (must be 2^n)
+  \param[in]   block_size  decimated block size in bytes (whole Q15 frames)
+  \return      return code (\ref SENSOR_DRV_ERROR_BUSY when block consumers are registered)
+*/
+int32_t SensorDrv_SetRxDecimator (SensorDecim_t *decim, void *buf, uint32_t block_num, uint32_t block_size);
+
+/**
+  \fn          int32_t SensorDrv_AddRxConsumer (void *mq_id)
+  \brief       Add Receiver block consumer.
+  \details     The sequence number (uint32_t) of every received block is put into the
+               message queue of each consumer from the receiver interrupt. Blocks are
+               not copied: consumers access them in the receive buffer with
+               \ref SensorDrv_GetRxBlockSeq and independently of each other.
+  \param[in]   mq_id       CMSIS-RTOS2 message queue ID (message size 4 bytes)
+  \return      consumer number (>= 0) or return code on error (\ref SENSOR_DRV_ERROR_BUSY
+               when all consumers are in use or a decimation stage is set)
+*/
+int32_t SensorDrv_AddRxConsumer (void *mq_id);
+
+/**
+  \fn          void *SensorDrv_GetRxBlockSeq (uint32_t consumer, uint32_t seq)
+  \brief       Get received block by sequence number.
+  \param[in]   consumer    consumer number
+  \param[in]   seq         block sequence number received from consumer message queue
+  \return      pointer to block in the receive buffer, NULL if the block was overwritten
+               (no release needed) or not received yet
+*/
+void *SensorDrv_GetRxBlockSeq (uint32_t consumer, uint32_t seq);
+
+/**
+  \fn          int32_t SensorDrv_ReleaseRxBlockSeq (uint32_t consumer, uint32_t seq)
+  \brief       Release received block obtained with \ref SensorDrv_GetRxBlockSeq.
+  \param[in]   consumer    consumer number
+  \param[in]   seq         block sequence number
+  \return      return code (\ref SENSOR_DRV_ERROR when the block was overwritten before release,
+               its data is not consistent)
+*/
+int32_t SensorDrv_ReleaseRxBlockSeq (uint32_t consumer, uint32_t seq);
+
+/**
+  \fn          int32_t SensorDrv_GetRxConsumerStats (uint32_t consumer, SensorDrv_ConsumerStats_t *stats)
+  \brief       Get Receiver block consumer statistics.
+  \param[in]   consumer    consumer number
+  \param[out]  stats       pointer to \ref SensorDrv_ConsumerStats_t
+  \return      return code
+*/
+int32_t SensorDrv_GetRxConsumerStats (uint32_t consumer, SensorDrv_ConsumerStats_t *stats);
+
 /**
   \fn          SensorDrv_Status_t SensorDrv_GetStatus (void)
   \brief       Get Sensor Interface status.
@@ -122,6 +250,17 @@ uint32_t SensorDrv_GetRxCount (void);
 */
 SensorDrv_Status_t SensorDrv_GetStatus (void);
 
+/**
+  \fn          int32_t SensorDrv_GetCounters (SensorDrv_Counters_t *counters)
+  \brief       Get lost block counters.
+  \details     Counters only increase (they are reset by \ref SensorDrv_Initialize) and are
+               not cleared on read: compute losses over an interval as the difference
+               of two snapshots.
+  \param[out]  counters    pointer to \ref SensorDrv_Counters_t
+  \return      return code
+*/
+int32_t SensorDrv_GetCounters (SensorDrv_Counters_t *counters);
+
 #ifdef  __cplusplus
 }
 #endif
@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ */
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "sensor_proc.h"
+
+#if defined(__ARM_FEATURE_MVE) && ((__ARM_FEATURE_MVE & 1) != 0) && !defined(SENSOR_PROC_NO_MVE)
+#include <arm_mve.h>
+#define SENSOR_PROC_MVEI        1                       /* Integer kernels use Helium */
+#if ((__ARM_FEATURE_MVE & 2) != 0)
+#define SENSOR_PROC_MVEF        1                       /* Floating-point kernels use Helium */
+#endif
+#endif
+
+/* Keep the reference loops scalar, so that they measure what they claim to */
+#if defined(__clang__)
+#define SCALAR_LOOP             _Pragma("clang loop vectorize(disable) interleave(disable)")
+#else
+#define SCALAR_LOOP
+#endif
+
+/* Scale factors of the float32 conversion (full scale = 1.0) */
+#define SCALE_S8                (1.0f / 128.0f)
+#define SCALE_S16               (1.0f / 32768.0f)
+#define SCALE_S32               (1.0f / 2147483648.0f)
+
+/* Remaining count after processing one vector of n lanes */
+#define TAIL(count, n)          (((count) > (n)) ? ((count) - (n)) : 0U)
+
+/* Finalize statistics from sum and sum of squares */
+static void Stats_Finalize (SensorProc_Stats_t *stats, int32_t min, int32_t max,
+                            float sum, float sum_sq, uint32_t count) {
+  stats->min  = min;
+  stats->max  = max;
+  stats->mean = sum    / (float)count;
+  stats->rms  = sqrtf(sum_sq / (float)count);
+}
+
+
+/*---------------------------------------------------------------------------
+ * Scalar reference implementations
+ *---------------------------------------------------------------------------*/
+
+void SensorProc_S8ToQ15_Scalar (const int8_t *src, int16_t *dst, uint32_t count) {
+  SCALAR_LOOP
+  for (uint32_t i = 0U; i < count; i++) {
+    dst[i] = (int16_t)((int32_t)src[i] * 256);
+  }
+}
+
+void SensorProc_S16ToQ15_Scalar (const int16_t *src, int16_t *dst, uint32_t count) {
+  if (src != dst) {
+    memmove(dst, src, count * sizeof(int16_t));
+  }
+}
+
+void SensorProc_S32ToQ15_Scalar (const int32_t *src, int16_t *dst, uint32_t count) {
+  int32_t v;
+
+  SCALAR_LOOP
+  for (uint32_t i = 0U; i < count; i++) {
+    v = (int32_t)(((int64_t)src[i] + 0x8000) >> 16);
+    dst[i] = (int16_t)((v > 32767) ? 32767 : v);
+  }
+}
+
+void SensorProc_S8ToF32_Scalar (const int8_t *src, float *dst, uint32_t count) {
+  SCALAR_LOOP
+  for (uint32_t i = 0U; i < count; i++) {
+    dst[i] = (float)src[i] * SCALE_S8;
+  }
+}
+
+void SensorProc_S16ToF32_Scalar (const int16_t *src, float *dst, uint32_t count) {
+  SCALAR_LOOP
+  for (uint32_t i = 0U; i < count; i++) {
+    dst[i] = (float)src[i] * SCALE_S16;
+  }
+}
+
+void SensorProc_S32ToF32_Scalar (const int32_t *src, float *dst, uint32_t count) {
+  SCALAR_LOOP
+  for (uint32_t i = 0U; i < count; i++) {
+    dst[i] = (float)src[i] * SCALE_S32;
+  }
+}
+
+void SensorProc_DeinterleaveQ15_Scalar (const int16_t *src, int16_t *dst, uint32_t channels, uint32_t frames) {
+  for (uint32_t c = 0U; c < channels; c++) {
+    SCALAR_LOOP
+    for (uint32_t i = 0U; i < frames; i++) {
+      dst[(c * frames) + i] = src[(i * channels) + c];
+    }
+  }
+}
+
+void SensorProc_DeinterleaveF32_Scalar (const float *src, float *dst, uint32_t channels, uint32_t frames) {
+  for (uint32_t c = 0U; c < channels; c++) {
+    SCALAR_LOOP
+    for (uint32_t i = 0U; i < frames; i++) {
+      dst[(c * frames) + i] = src[(i * channels) + c];
+    }
+  }
+}
+
+void SensorProc_StatsS8_Scalar (const int8_t *src, uint32_t count, SensorProc_Stats_t *stats) {
+  int32_t min = INT8_MAX;
+  int32_t max = INT8_MIN;
+  int64_t sum = 0;
+  int64_t sum_sq = 0;
+  int32_t v;
+
+  SCALAR_LOOP
+  for (uint32_t i = 0U; i < count; i++) {
+    v = src[i];
+    if (v < min) { min = v; }
+    if (v > max) { max = v; }
+    sum    += v;
+    sum_sq += v * v;
+  }
+
+  Stats_Finalize(stats, min, max, (float)sum, (float)sum_sq, count);
+}
+
+void SensorProc_StatsS16_Scalar (const int16_t *src, uint32_t count, SensorProc_Stats_t *stats) {
+  int32_t min = INT16_MAX;
+  int32_t max = INT16_MIN;
+  int64_t sum = 0;
+  int64_t sum_sq = 0;
+  int32_t v;
+
+  SCALAR_LOOP
+  for (uint32_t i = 0U; i < count; i++) {
+    v = src[i];
+    if (v < min) { min = v; }
+    if (v > max) { max = v; }
+    sum    += v;
+    sum_sq += v * v;
+  }
+
+  Stats_Finalize(stats, min, max, (float)sum, (float)sum_sq, count);
+}
+
+void SensorProc_StatsS32_Scalar (const int32_t *src, uint32_t count, SensorProc_Stats_t *stats) {
+  int32_t min = INT32_MAX;
+  int32_t max = INT32_MIN;
+  int64_t sum = 0;
+  float   sum_sq = 0.0f;
+  float   f;
+  int32_t v;
+
+  /* Squares of int32 samples overflow 64-bit sums, accumulate normalized values */
+  SCALAR_LOOP
+  for (uint32_t i = 0U; i < count; i++) {
+    v = src[i];
+    if (v < min) { min = v; }
+    if (v > max) { max = v; }
+    sum    += v;
+    f       = (float)v * SCALE_S32;
+    sum_sq += f * f;
+  }
+
+  Stats_Finalize(stats, min, max, (float)sum, sum_sq / (SCALE_S32 * SCALE_S32), count);
+}
+
+int64_t SensorProc_DotQ15_Scalar (const int16_t *a, const int16_t *b, uint32_t count) {
+  int64_t sum = 0;
+
+  SCALAR_LOOP
+  for (uint32_t i = 0U; i < count; i++) {
+    sum += (int32_t)a[i] * b[i];
+  }
+
+  return sum;
+}
+
+
+/*---------------------------------------------------------------------------
+ * Helium (MVE) implementations
+ *---------------------------------------------------------------------------*/
+
+#ifdef SENSOR_PROC_MVEI
+
+void SensorProc_S8ToQ15 (const int8_t *src, int16_t *dst, uint32_t count) {
+  mve_pred16_t p;
+  int16x8_t    v;
+
+  while (count > 0U) {
+    p = vctp16q(count);
+    v = vldrbq_z_s16(src, p);                           /* load and sign-extend 8 samples */
+    v = vshlq_n_s16(v, 8);
+    vst1q_p_s16(dst, v, p);
+    src  += 8;
+    dst  += 8;
+    count = TAIL(count, 8U);
+  }
+}
+
+void SensorProc_S16ToQ15 (const int16_t *src, int16_t *dst, uint32_t count) {
+  SensorProc_S16ToQ15_Scalar(src, dst, count);
+}
+
+void SensorProc_S32ToQ15 (const int32_t *src, int16_t *dst, uint32_t count) {
+  mve_pred16_t p;
+  int32x4_t    v;
+
+  while (count > 0U) {
+    p = vctp32q(count);
+    v = vld1q_z_s32(src, p);
+    v = vrshrq_n_s32(v, 16);
+    v = vminq_s32(v, vdupq_n_s32(32767));               /* rounding up of 0x7FFFxxxx */
+    vstrhq_p_s32(dst, v, p);                            /* narrowing store */
+    src  += 4;
+    dst  += 4;
+    count = TAIL(count, 4U);
+  }
+}
+
+void SensorProc_DeinterleaveQ15 (const int16_t *src, int16_t *dst, uint32_t channels, uint32_t frames) {
+  mve_pred16_t p;
+  uint16x8_t   offset;
+  uint32_t     i, n;
+
+  if (channels == 1U) {
+    SensorProc_S16ToQ15_Scalar(src, dst, frames);
+    return;
+  }
+
+  if ((channels == 2U) || (channels == 4U)) {
+    /* Structure loads split 8 frames into channel vectors at once */
+    for (i = 0U; (i + 8U) <= frames; i += 8U) {
+      if (channels == 2U) {
+        int16x8x2_t v = vld2q_s16(&src[i * 2U]);
+        vst1q_s16(&dst[i],          v.val[0]);
+        vst1q_s16(&dst[frames + i], v.val[1]);
+      } else {
+        int16x8x4_t v = vld4q_s16(&src[i * 4U]);
+        vst1q_s16(&dst[i],                 v.val[0]);
+        vst1q_s16(&dst[frames + i],        v.val[1]);
+        vst1q_s16(&dst[(2U * frames) + i], v.val[2]);
+        vst1q_s16(&dst[(3U * frames) + i], v.val[3]);
+      }
+    }
+    for (uint32_t c = 0U; c < channels; c++) {
+      for (n = i; n < frames; n++) {
+        dst[(c * frames) + n] = src[(n * channels) + c];
+      }
+    }
+    return;
+  }
+
+  /* Any other channel count: gather 8 frames of one channel per load */
+  offset = vmulq_n_u16(vidupq_n_u16(0U, 1), (uint16_t)channels);
+  for (uint32_t c = 0U; c < channels; c++) {
+    for (i = 0U, n = frames; n > 0U; i += 8U, n = TAIL(n, 8U)) {
+      p = vctp16q(n);
+      vst1q_p_s16(&dst[(c * frames) + i],
+                  vldrhq_gather_shifted_offset_z_s16(&src[(i * channels) + c], offset, p), p);
+    }
+  }
+}
+
+void SensorProc_StatsS8 (const int8_t *src, uint32_t count, SensorProc_Stats_t *stats) {
+  mve_pred16_t p;
+  int16x8_t    v;
+  int16_t      min = INT8_MAX;
+  int16_t      max = INT8_MIN;
+  int64_t      sum = 0;
+  int64_t      sum_sq = 0;
+  uint32_t     n = count;
+
+  while (n > 0U) {
+    p       = vctp16q(n);
+    v       = vldrbq_z_s16(src, p);
+    min     = vminvq_p_s16(min, v, p);
+    max     = vmaxvq_p_s16(max, v, p);
+    sum    += vaddvq_p_s16(v, p);
+    sum_sq  = vmlaldavaq_p_s16(sum_sq, v, v, p);
+    src    += 8;
+    n       = TAIL(n, 8U);
+  }
+
+  Stats_Finalize(stats, min, max, (float)sum, (float)sum_sq, count);
+}
+
+void SensorProc_StatsS16 (const int16_t *src, uint32_t count, SensorProc_Stats_t *stats) {
+  mve_pred16_t p;
+  int16x8_t    v;
+  int16_t      min = INT16_MAX;
+  int16_t      max = INT16_MIN;
+  int64_t      sum = 0;
+  int64_t      sum_sq = 0;
+  uint32_t     n = count;
+
+  while (n > 0U) {
+    p       = vctp16q(n);
+    v       = vld1q_z_s16(src, p);
+    min     = vminvq_p_s16(min, v, p);
+    max     = vmaxvq_p_s16(max, v, p);
+    sum    += vaddvq_p_s16(v, p);
+    sum_sq  = vmlaldavaq_p_s16(sum_sq, v, v, p);
+    src    += 8;
+    n       = TAIL(n, 8U);
+  }
+
+  Stats_Finalize(stats, min, max, (float)sum, (float)sum_sq, count);
+}
+
+int64_t SensorProc_DotQ15 (const int16_t *a, const int16_t *b, uint32_t count) {
+  mve_pred16_t p;
+  int64_t      sum = 0;
+
+  while (count > 0U) {
+    p     = vctp16q(count);
+    sum   = vmlaldavaq_p_s16(sum, vld1q_z_s16(a, p), vld1q_z_s16(b, p), p);
+    a    += 8;
+    b    += 8;
+    count = TAIL(count, 8U);
+  }
+
+  return sum;
+}
+
+#else
+
+void SensorProc_S8ToQ15 (const int8_t *src, int16_t *dst, uint32_t count) {
+  SensorProc_S8ToQ15_Scalar(src, dst, count);
+}
+
+void SensorProc_S16ToQ15 (const int16_t *src, int16_t *dst, uint32_t count) {
+  SensorProc_S16ToQ15_Scalar(src, dst, count);
+}
+
+void SensorProc_S32ToQ15 (const int32_t *src, int16_t *dst, uint32_t count) {
+  SensorProc_S32ToQ15_Scalar(src, dst, count);
+}
+
+void SensorProc_DeinterleaveQ15 (const int16_t *src, int16_t *dst, uint32_t channels, uint32_t frames) {
+  SensorProc_DeinterleaveQ15_Scalar(src, dst, channels, frames);
+}
+
+void SensorProc_StatsS8 (const int8_t *src, uint32_t count, SensorProc_Stats_t *stats) {
+  SensorProc_StatsS8_Scalar(src, count, stats);
+}
+
+void SensorProc_StatsS16 (const int16_t *src, uint32_t count, SensorProc_Stats_t *stats) {
+  SensorProc_StatsS16_Scalar(src, count, stats);
+}
+
+int64_t SensorProc_DotQ15 (const int16_t *a, const int16_t *b, uint32_t count) {
+  return SensorProc_DotQ15_Scalar(a, b, count);
+}
+
+#endif /* SENSOR_PROC_MVEI */
+
+#ifdef SENSOR_PROC_MVEF
+
+void SensorProc_S8ToF32 (const int8_t *src, float *dst, uint32_t count) {
+  mve_pred16_t p;
+
+  while (count > 0U) {
+    p = vctp32q(count);
+    vst1q_p_f32(dst, vcvtq_n_f32_s32(vldrbq_z_s32(src, p), 7), p);
+    src  += 4;
+    dst  += 4;
+    count = TAIL(count, 4U);
+  }
+}
+
+void SensorProc_S16ToF32 (const int16_t *src, float *dst, uint32_t count) {
+  mve_pred16_t p;
+
+  while (count > 0U) {
+    p = vctp32q(count);
+    vst1q_p_f32(dst, vcvtq_n_f32_s32(vldrhq_z_s32(src, p), 15), p);
+    src  += 4;
+    dst  += 4;
+    count = TAIL(count, 4U);
+  }
+}
+
+void SensorProc_S32ToF32 (const int32_t *src, float *dst, uint32_t count) {
+  mve_pred16_t p;
+
+  while (count > 0U) {
+    p = vctp32q(count);
+    vst1q_p_f32(dst, vcvtq_n_f32_s32(vld1q_z_s32(src, p), 31), p);
+    src  += 4;
+    dst  += 4;
+    count = TAIL(count, 4U);
+  }
+}
+
+void SensorProc_DeinterleaveF32 (const float *src, float *dst, uint32_t channels, uint32_t frames) {
+  mve_pred16_t p;
+  uint32x4_t   offset;
+  uint32_t     i, n;
+
+  if (channels == 1U) {
+    memmove(dst, src, frames * sizeof(float));
+    return;
+  }
+
+  if ((channels == 2U) || (channels == 4U)) {
+    /* Structure loads split 4 frames into channel vectors at once */
+    for (i = 0U; (i + 4U) <= frames; i += 4U) {
+      if (channels == 2U) {
+        float32x4x2_t v = vld2q_f32(&src[i * 2U]);
+        vst1q_f32(&dst[i],          v.val[0]);
+        vst1q_f32(&dst[frames + i], v.val[1]);
+      } else {
+        float32x4x4_t v = vld4q_f32(&src[i * 4U]);
+        vst1q_f32(&dst[i],                 v.val[0]);
+        vst1q_f32(&dst[frames + i],        v.val[1]);
+        vst1q_f32(&dst[(2U * frames) + i], v.val[2]);
+        vst1q_f32(&dst[(3U * frames) + i], v.val[3]);
+      }
+    }
+    for (uint32_t c = 0U; c < channels; c++) {
+      for (n = i; n < frames; n++) {
+        dst[(c * frames) + n] = src[(n * channels) + c];
+      }
+    }
+    return;
+  }
+
+  /* Any other channel count: gather 4 frames of one channel per load */
+  offset = vmulq_n_u32(vidupq_n_u32(0U, 1), channels);
+  for (uint32_t c = 0U; c < channels; c++) {
+    for (i = 0U, n = frames; n > 0U; i += 4U, n = TAIL(n, 4U)) {
+      p = vctp32q(n);
+      vst1q_p_f32(&dst[(c * frames) + i],
+                  vldrwq_gather_shifted_offset_z_f32(&src[(i * channels) + c], offset, p), p);
+    }
+  }
+}
+
+void SensorProc_StatsS32 (const int32_t *src, uint32_t count, SensorProc_Stats_t *stats) {
+  mve_pred16_t p;
+  int32x4_t    v;
+  float32x4_t  f;
+  float32x4_t  acc_sq = vdupq_n_f32(0.0f);
+  int32_t      min = INT32_MAX;
+  int32_t      max = INT32_MIN;
+  int64_t      sum = 0;
+  float        sum_sq;
+  uint32_t     n = count;
+
+  while (n > 0U) {
+    p      = vctp32q(n);
+    v      = vld1q_z_s32(src, p);                       /* inactive lanes are zero */
+    min    = vminvq_p_s32(min, v, p);
+    max    = vmaxvq_p_s32(max, v, p);
+    sum    = vaddlvaq_p_s32(sum, v, p);
+    f      = vcvtq_n_f32_s32(v, 31);
+    acc_sq = vfmaq_f32(acc_sq, f, f);
+    src   += 4;
+    n      = TAIL(n, 4U);
+  }
+  sum_sq = vgetq_lane_f32(acc_sq, 0) + vgetq_lane_f32(acc_sq, 1) +
+           vgetq_lane_f32(acc_sq, 2) + vgetq_lane_f32(acc_sq, 3);
+
+  Stats_Finalize(stats, min, max, (float)sum, sum_sq / (SCALE_S32 * SCALE_S32), count);
+}
+
+#else
+
+void SensorProc_S8ToF32 (const int8_t *src, float *dst, uint32_t count) {
+  SensorProc_S8ToF32_Scalar(src, dst, count);
+}
+
+void SensorProc_S16ToF32 (const int16_t *src, float *dst, uint32_t count) {
+  SensorProc_S16ToF32_Scalar(src, dst, count);
+}
+
+void SensorProc_S32ToF32 (const int32_t *src, float *dst, uint32_t count) {
+  SensorProc_S32ToF32_Scalar(src, dst, count);
+}
+
+void SensorProc_DeinterleaveF32 (const float *src, float *dst, uint32_t channels, uint32_t frames) {
+  SensorProc_DeinterleaveF32_Scalar(src, dst, channels, frames);
+}
+
+void SensorProc_StatsS32 (const int32_t *src, uint32_t count, SensorProc_Stats_t *stats) {
+  SensorProc_StatsS32_Scalar(src, count, stats);
+}
+
+#endif /* SENSOR_PROC_MVEF */
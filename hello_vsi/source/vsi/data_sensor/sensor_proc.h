@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ */
+
+#ifndef __SENSOR_PROC_H
+#define __SENSOR_PROC_H
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/*
+ * Sensor block processing kernels
+ *
+ * Operate in place on received blocks (see SensorDrv_GetRxBlock). When the
+ * target supports Helium (M-profile Vector Extension) the kernels use MVE
+ * intrinsics with tail predication, otherwise they fall back to the scalar
+ * implementations (suffix _Scalar), which are always available as reference.
+ *
+ * Sample counts are in samples (frames * channels for interleaved data).
+ * Q15 conversion of int32 samples rounds and saturates, float32 results are
+ * normalized to [-1.0, 1.0).
+ */
+
+/**
+\brief Block statistics
+*/
+typedef struct {
+  int32_t min;                          ///< Minimum sample value
+  int32_t max;                          ///< Maximum sample value
+  float   mean;                         ///< Mean sample value
+  float   rms;                          ///< Root mean square of the sample values
+} SensorProc_Stats_t;
+
+/* Sample conversion */
+void SensorProc_S8ToQ15  (const int8_t  *src, int16_t *dst, uint32_t count);
+void SensorProc_S16ToQ15 (const int16_t *src, int16_t *dst, uint32_t count);
+void SensorProc_S32ToQ15 (const int32_t *src, int16_t *dst, uint32_t count);
+void SensorProc_S8ToF32  (const int8_t  *src, float   *dst, uint32_t count);
+void SensorProc_S16ToF32 (const int16_t *src, float   *dst, uint32_t count);
+void SensorProc_S32ToF32 (const int32_t *src, float   *dst, uint32_t count);
+
+/* De-interleave frames of channels samples into planar buffer dst (channel c at dst + c * frames) */
+void SensorProc_DeinterleaveQ15 (const int16_t *src, int16_t *dst, uint32_t channels, uint32_t frames);
+void SensorProc_DeinterleaveF32 (const float   *src, float   *dst, uint32_t channels, uint32_t frames);
+
+/* Block statistics (count > 0) */
+void SensorProc_StatsS8  (const int8_t  *src, uint32_t count, SensorProc_Stats_t *stats);
+void SensorProc_StatsS16 (const int16_t *src, uint32_t count, SensorProc_Stats_t *stats);
+void SensorProc_StatsS32 (const int32_t *src, uint32_t count, SensorProc_Stats_t *stats);
+
+/* Dot product of two Q15 vectors (Q30 result in 64-bit accumulator) */
+int64_t SensorProc_DotQ15 (const int16_t *a, const int16_t *b, uint32_t count);
+
+/* Scalar reference implementations */
+void SensorProc_S8ToQ15_Scalar  (const int8_t  *src, int16_t *dst, uint32_t count);
+void SensorProc_S16ToQ15_Scalar (const int16_t *src, int16_t *dst, uint32_t count);
+void SensorProc_S32ToQ15_Scalar (const int32_t *src, int16_t *dst, uint32_t count);
+void SensorProc_S8ToF32_Scalar  (const int8_t  *src, float   *dst, uint32_t count);
+void SensorProc_S16ToF32_Scalar (const int16_t *src, float   *dst, uint32_t count);
+void SensorProc_S32ToF32_Scalar (const int32_t *src, float   *dst, uint32_t count);
+void SensorProc_DeinterleaveQ15_Scalar (const int16_t *src, int16_t *dst, uint32_t channels, uint32_t frames);
+void SensorProc_DeinterleaveF32_Scalar (const float   *src, float   *dst, uint32_t channels, uint32_t frames);
+void SensorProc_StatsS8_Scalar  (const int8_t  *src, uint32_t count, SensorProc_Stats_t *stats);
+void SensorProc_StatsS16_Scalar (const int16_t *src, uint32_t count, SensorProc_Stats_t *stats);
+void SensorProc_StatsS32_Scalar (const int32_t *src, uint32_t count, SensorProc_Stats_t *stats);
+int64_t SensorProc_DotQ15_Scalar (const int16_t *a, const int16_t *b, uint32_t count);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_PROC_H */
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ */
+
+/* Generated by vsi_regmap.py from sensor_regs.json, do not edit */
+
+#ifndef __SENSOR_REGS_H
+#define __SENSOR_REGS_H
+
+/* Sensor Peripheral registers (VSI user registers) */
+#define CONTROL_Idx                     0U
+#define CONTROL                         Regs[CONTROL_Idx]               /* Control receiver/transmitter */
+#define CHANNELS_Idx                    1U
+#define CHANNELS                        Regs[CHANNELS_Idx]              /* Number of channels */
+#define SAMPLE_BITS_Idx                 2U
+#define SAMPLE_BITS                     Regs[SAMPLE_BITS_Idx]           /* Sample number of bits (8..32) */
+#define SAMPLE_RATE_Idx                 3U
+#define SAMPLE_RATE                     Regs[SAMPLE_RATE_Idx]           /* Sample rate (samples per second) */
+#define UNDERFLOW_Idx                   4U
+#define UNDERFLOW                       Regs[UNDERFLOW_Idx]             /* Incomplete blocks (monotonic), read-only */
+#define OVERFLOW_Idx                    5U
+#define OVERFLOW                        Regs[OVERFLOW_Idx]              /* Dropped blocks (monotonic), read-only */
+#define INTERVAL_Idx                    6U
+#define INTERVAL                        Regs[INTERVAL_Idx]              /* Replay: interval to next block in us (0 = not timestamped), read-only */
+
+/* Sensor CONTROL register definitions */
+#define CONTROL_ENABLE_Pos              0U                              /* CONTROL: Enable */
+#define CONTROL_ENABLE_Msk              (1UL << CONTROL_ENABLE_Pos)
+#define CONTROL_FREE_RUN_Pos            1U                              /* CONTROL: Blocks requested as fast as consumed (receiver) */
+#define CONTROL_FREE_RUN_Msk            (1UL << CONTROL_FREE_RUN_Pos)
+
+/* Sensor IRQ Status register definitions */
+#define IRQ_Status_DATA_Pos             0U                              /* IRQ Status: data block transferred (VSI_STREAM_IRQ_BLOCK_Msk) */
+#define IRQ_Status_DATA_Msk             (1UL << IRQ_Status_DATA_Pos)
+#define IRQ_Status_OVERFLOW_Pos         1U                              /* IRQ Status: block dropped */
+#define IRQ_Status_OVERFLOW_Msk         (1UL << IRQ_Status_OVERFLOW_Pos)
+#define IRQ_Status_UNDERFLOW_Pos        2U                              /* IRQ Status: block incomplete */
+#define IRQ_Status_UNDERFLOW_Msk        (1UL << IRQ_Status_UNDERFLOW_Pos)
+#define IRQ_Status_Msk                  (IRQ_Status_DATA_Msk | IRQ_Status_OVERFLOW_Msk | IRQ_Status_UNDERFLOW_Msk)
+
+#endif /* __SENSOR_REGS_H */
@@ -12,6 +12,10 @@
 
 import logging
 import os
+import time
+import vsi_sensor_data
+import sensor_regs
+from sensor_regs import *
 
 ## Set verbosity level
 #verbosity = logging.DEBUG
@@ -44,19 +48,22 @@ DMA_Control_Direction_Msk = 1<<1
 DMA_Control_Direction_P2M = 0<<1
 DMA_Control_Direction_M2P = 1<<1
 
-# User registers
+# User registers (register map and IRQ Status bits generated from sensor_regs.json, see vsi_regmap.py)
 Regs = [0] * 64
 
 CONTROL     = 0  # Regs[0]
 CHANNELS    = 0  # Regs[1]
 SAMPLE_BITS = 0  # Regs[2]
 SAMPLE_RATE = 0  # Regs[3]
+UNDERFLOW   = 0  # Regs[4]: blocks delivered incomplete (monotonic, read-only)
+OVERFLOW    = 0  # Regs[5]: blocks dropped (monotonic, read-only)
+INTERVAL    = 0  # Regs[6]: timestamped replay, interval to next block in microseconds (0 = not timestamped, read-only)
 
-# User CONTROL register definitions
-CONTROL_ENABLE_Msk = 1<<0
+# Sensor data files (first existing file is used, binary format is detected by its header)
+data_files = ('intdata.bin', 'intdata.txt')
 
-# Current index in sensor data
-index = 0
+# Sensor data reader
+Reader = None
 
 # Flag for end of file
 eof = 0
@@ -64,58 +71,106 @@ eof = 0
 # Data buffer
 Data = bytearray()
 
+# Pending IRQ Status bits reported at next Timer event
+IRQ_Pending = 0
+
+# Free-running mode statistics (blocks, bytes, wall clock start time)
+FreeRun = None
+
+# Native model core (vsi_sensor_core extension, see setup.py), None when using the Python implementation
+USE_NATIVE_CORE = True
+Core = None
+
 ## Open FILE file (store object into global FILE object)
 #  @param name name of FILE file to open
 def openFILE(name):
-    global FILE
-    global file_content
-    global index
+    global Reader
     global eof
 
-    logging.info("Open data file (read mode): {}".format(name))
-    
-    FILE = open(name, 'r')
-    
-    # get the file size for logging
-    FILE.seek(0, os.SEEK_END)
-    file_size = FILE.tell()
-    FILE.seek(0)
-    file_content = FILE.read()
-    file_content = file_content.split()
-    index = 0
-    eof   = 0
-    logging.info("  Number of Bytes: {}".format(file_size))
+    logging.info("Open data file (read mode): %s", name)
+
+    if vsi_sensor_data.isBinaryFile(name):
+        Reader = vsi_sensor_data.BinaryReader(name)
+        if Reader.timestamped:
+            logging.info("Timestamped replay")
+        if (Reader.channels != CHANNELS) or (Reader.sample_bits != SAMPLE_BITS):
+            logging.warning("Data file format ({} channels, {} bits) differs from configuration ({} channels, {} bits)".format(
+                            Reader.channels, Reader.sample_bits, CHANNELS, SAMPLE_BITS))
+    else:
+        Reader = vsi_sensor_data.TextReader(name, SAMPLE_BITS)
+    eof = 0
+    setInterval()
+    logging.info("  Number of Bytes: %s", Reader.size)
 
 ## Close FILE file (global FILE object)
 def closeFILE():
-    global FILE
+    global Reader
     logging.info("Close FILE file")
-    FILE.close()
+    if Reader is not None:
+        Reader.close()
+        Reader = None
+    setInterval()
+
+## Start free-running mode statistics
+def startFreeRun():
+    global FreeRun
+    FreeRun = { 'blocks': 0, 'bytes': 0, 'start': time.perf_counter() }
+
+## Report free-running mode throughput (once, at end of data or when the receiver is disabled)
+def reportFreeRun():
+    global FreeRun
+    if FreeRun is None:
+        return
+    if Core is not None:
+        FreeRun['blocks'] = Core.blocks
+        FreeRun['bytes']  = Core.bytes
+    wall = time.perf_counter() - FreeRun['start']
+    rate = (FreeRun['blocks'] / wall) if wall > 0 else 0
+    frame_size = CHANNELS * ((SAMPLE_BITS + 7) // 8)
+    frames = (FreeRun['bytes'] // frame_size) if frame_size != 0 else 0
+    print("Py: VSI0: Free-running: {} blocks ({} bytes, {} frames) in {:.3f} s wall time: {:.1f} blocks/s, {:.0f} frames/s".format(
+          FreeRun['blocks'], FreeRun['bytes'], frames, wall, rate, (frames / wall) if wall > 0 else 0), flush=True)
+    FreeRun = None
+
+## Update INTERVAL register from timestamped replay (interval from current to next block)
+def setInterval():
+    global INTERVAL
+    INTERVAL = getattr(Reader, 'interval', 0) if Reader is not None else 0
 
 ## Read next block of sensor data
-# @param - block size
-def readNextBlock(size):
-    global file_content, index, eof, Regs
-    logging.info("Trying to read {} frames".format(size))
-    frames = file_content[index:(index+size)]
-    if(len(frames)!=0):
-        index += size
-    else:
+#  @param frames number of frames to read
+#  @return data interleaved frames packed to SAMPLE_BITS (bytes)
+def readNextBlock(frames):
+    global eof
+    logging.info("Trying to read %s frames", frames)
+    frame_size = CHANNELS * ((SAMPLE_BITS + 7) // 8)
+    data = Reader.read(frames * frame_size)
+    setInterval()
+    if len(data) == 0:
         eof = 1
-        Regs[0] = 0
         logging.debug("End of File reached")
+        reportFreeRun()
+    elif FreeRun is not None:
+        FreeRun['blocks'] += 1
+        FreeRun['bytes']  += len(data)
 
-    return bytearray([int(x) for x in frames])
+    return data
 
 ## Load sensor frames into global Data buffer
 #  @param block_size size of block to load (in bytes)
 def loadSensorFrames(block_size):
-    global Data
+    global Data, UNDERFLOW, IRQ_Pending
     logging.info("Load sensor frames into data buffer")
     frame_size = CHANNELS * ((SAMPLE_BITS + 7) // 8)
     frames_max = block_size // frame_size
     Data = readNextBlock(frames_max)
 
+    # Underflow: sensor data ran out within the block (rest of block is padding)
+    if 0 < len(Data) < (frames_max * frame_size):
+        UNDERFLOW = (UNDERFLOW + 1) & 0xFFFFFFFF
+        IRQ_Pending |= IRQ_Status_UNDERFLOW_Msk
+        logging.warning("Underflow: %s of %s bytes available", len(Data), frames_max * frame_size)
+
 
 ## Initialize
 def init():
@@ -129,7 +184,7 @@ def rdIRQ():
     logging.info("Python function rdIRQ() called")
 
     value = IRQ_Status
-    logging.debug("Read interrupt request: {}".format(value))
+    logging.debug("Read interrupt request: %s", value)
 
     return value
 
@@ -141,11 +196,11 @@ def wrIRQ(value):
     global IRQ_Status, eof
     logging.info("Python function wrIRQ() called")
 
-    # No IRQ if end of file reached
+    # No data IRQ if end of file reached (pending overflow/underflow still reported)
     if (eof):
-        value = 0
+        value &= ~IRQ_Status_DATA_Msk
     IRQ_Status = value
-    logging.debug("Write interrupt request: {}".format(value))
+    logging.debug("Write interrupt request: %s", value)
 
     return value
 
@@ -160,17 +215,21 @@ def wrTimer(index, value):
 
     if index == 0:
         Timer_Control = value
-        logging.debug("Write Timer_Control: {}".format(value))
+        logging.debug("Write Timer_Control: %s", value)
     elif index == 1:
         Timer_Interval = value
-        logging.debug("Write Timer_Interval: {}".format(value))
+        logging.debug("Write Timer_Interval: %s", value)
 
     return value
 
 ## Timer event (called at Timer Overflow)
 def timerEvent():
+    global IRQ_Status, IRQ_Pending
     logging.info("Python function timerEvent() called")
 
+    IRQ_Status |= IRQ_Pending
+    IRQ_Pending = 0
+
 
 ## Write DMA registers (the VSI DMA Registers)
 #  @param index DMA register index (zero based)
@@ -182,7 +241,7 @@ def wrDMA(index, value):
 
     if index == 0:
         DMA_Control = value
-        logging.debug("Write DMA_Control: {}".format(value))
+        logging.debug("Write DMA_Control: %s", value)
 
     return value
 
@@ -195,11 +254,12 @@ def rdDataDMA(size):
     logging.info("Python function rdDataDMA() called")
 
     loadSensorFrames(size)
-    logging.debug("Obtained {} bytes)".format(len(Data)))
+    logging.debug("Obtained %s bytes)", len(Data))
     if (len(Data)!= 0):
-      n = min(len(Data), size)
+      if len(Data) >= size:
+        return Data[0:size]
       data = bytearray(size)
-      data[0:n] = Data[0:n]
+      data[0:len(Data)] = Data
       return data
 
 
@@ -211,7 +271,7 @@ def wrDataDMA(data, size):
     logging.info("Python function wrDataDMA() called")
 
     Data = data
-    logging.debug("Write data ({} bytes)".format(size))
+    logging.debug("Write data (%s bytes)", size)
 
     return
 
@@ -223,43 +283,58 @@ def wrCONTROL(value):
     if ((value ^ CONTROL) & CONTROL_ENABLE_Msk) != 0:
         if (value & CONTROL_ENABLE_Msk) != 0:
             logging.info("Enable Receiver")
-            openFILE('intdata.txt')
+            openFILE(next((f for f in data_files if os.path.isfile(f)), data_files[-1]))
+            if (value & CONTROL_FREE_RUN_Msk) != 0:
+                logging.info("Free-running mode")
+                startFreeRun()
         else:
             logging.info("Disable Receiver")
+            reportFreeRun()
             closeFILE()
     CONTROL = value
+    return value
+
+## Read CONTROL register (user register)
+#  @return value CONTROL register, 0 after end of file (32-bit)
+def rdCONTROL():
+    return 0 if eof else CONTROL
 
 ## Write CHANNELS register (user register)
 #  @param value value to write (32-bit)
 def wrCHANNELS(value):
     global CHANNELS
     CHANNELS = value
-    logging.info("Number of channels: {}".format(value))
+    logging.info("Number of channels: %s", value)
+    return value
 
 ## Write SAMPLE_BITS register (user register)
 #  @param value value to write (32-bit)
 def wrSAMPLE_BITS(value):
     global SAMPLE_BITS
     SAMPLE_BITS = value
-    logging.info("Sample bits: {}".format(value))
+    logging.info("Sample bits: %s", value)
+    return value
 
 ## Write SAMPLE_RATE register (user register)
 #  @param value value to write (32-bit)
 def wrSAMPLE_RATE(value):
     global SAMPLE_RATE
     SAMPLE_RATE = value
-    logging.info("Sample rate: {}".format(value))
+    logging.info("Sample rate: %s", value)
+    return value
 
 
 ## Read user registers (the VSI User Registers)
 #  @param index user register index (zero based)
 #  @return value value read (32-bit)
 def rdRegs(index):
-    global Regs
     logging.info("Python function rdRegs() called")
 
-    value = Regs[index]
-    logging.debug("Read user register at index {}: {}".format(index, value))
+    if index < REG_NUM:
+        value = RegsRd[index]()
+    else:
+        value = Regs[index]
+    logging.debug("Read user register at index %s: %s", index, value)
 
     return value
 
@@ -272,20 +347,60 @@ def wrRegs(index, value):
     global Regs
     logging.info("Python function wrRegs() called")
 
-    if   index == 0:
-        wrCONTROL(value)
-    elif index == 1:
-        wrCHANNELS(value)
-    elif index == 2:
-        wrSAMPLE_BITS(value)
-    elif index == 3:
-        wrSAMPLE_RATE(value)
-
-    Regs[index] = value
-    logging.debug("Write user register at index {}: {}".format(index, value))
+    if index < REG_NUM:
+        value = RegsWr[index](value)
+    else:
+        Regs[index] = value
+    logging.debug("Write user register at index %s: %s", index, value)
 
     return value
 
 
+# User register dispatch tables (indexed by register index)
+RegsRd, RegsWr = sensor_regs.dispatch(globals())
+
+
+## Receiver enabled or disabled in native core: open/close data file and hand its samples to the core
+#  @param value CONTROL register value (32-bit)
+def coreControl(value):
+    global CHANNELS, SAMPLE_BITS, SAMPLE_RATE
+    CHANNELS    = Core.rdRegs(CHANNELS_Idx)
+    SAMPLE_BITS = Core.rdRegs(SAMPLE_BITS_Idx)
+    SAMPLE_RATE = Core.rdRegs(SAMPLE_RATE_Idx)
+    wrCONTROL(value)
+    if Reader is None:
+        return
+    if isinstance(Reader, vsi_sensor_data.BinaryReader):
+        Core.set_source(Reader.mm, Reader.offset, Reader.timestamped)
+    else:
+        Core.set_source(vsi_sensor_data.packSamples(Reader.samples, SAMPLE_BITS, Reader.signed))
+
+## End of data reached in native core
+def coreEndOfData():
+    logging.debug("End of File reached")
+    reportFreeRun()
+
+
+# Use native core for the VSI callbacks when the extension is available (Python implementation above is the fallback)
+if USE_NATIVE_CORE:
+    try:
+        import vsi_sensor_core
+        Core = vsi_sensor_core.Sensor(coreControl, coreEndOfData)
+        logging.info("Using native model core")
+    except ImportError:
+        logging.info("Native model core not available, using Python implementation")
+
+if Core is not None:
+    rdIRQ      = Core.rdIRQ
+    wrIRQ      = Core.wrIRQ
+    wrTimer    = Core.wrTimer
+    timerEvent = Core.timerEvent
+    wrDMA      = Core.wrDMA
+    rdDataDMA  = Core.rdDataDMA
+    wrDataDMA  = Core.wrDataDMA
+    rdRegs     = Core.rdRegs
+    wrRegs     = Core.wrRegs
+
+
 ## @}
 
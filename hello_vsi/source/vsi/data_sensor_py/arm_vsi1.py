@@ -11,7 +11,9 @@
 #More details.
 
 import logging
-import os
+import vsi_sensor_data
+import sensor_regs
+from sensor_regs import *
 
 
 ## Set verbosity level
@@ -46,61 +48,79 @@ DMA_Control_Direction_Msk = 1<<1
 DMA_Control_Direction_P2M = 0<<1
 DMA_Control_Direction_M2P = 1<<1
 
-# User registers
+# User registers (register map and IRQ Status bits generated from sensor_regs.json, see vsi_regmap.py)
 Regs = [0] * 64
 
 CONTROL     = 0  # Regs[0]
 CHANNELS    = 0  # Regs[1]
 SAMPLE_BITS = 0  # Regs[2]
 SAMPLE_RATE = 0  # Regs[3]
+UNDERFLOW   = 0  # Regs[4]: blocks delivered incomplete (monotonic, read-only)
+OVERFLOW    = 0  # Regs[5]: blocks dropped (monotonic, read-only)
 
-# User CONTROL register definitions
-CONTROL_ENABLE_Msk = 1<<0
+# Output data file (binary sensor data format, see vsi_sensor_data.py)
+data_file = 'test.bin'
+
+# Number of blocks queued for the background writer
+WRITER_QUEUE_DEPTH = 64
+
+# Record simulated timestamp of each block (timestamped capture, format version 2)
+CAPTURE_TIMESTAMPS = False
+
+# Writer queue full: block until space is available (True) or drop block and report overflow (False)
+WRITER_BLOCK_ON_FULL = False
+
+# Output data writer
+Writer = None
 
 # Data buffer
 Data = bytearray()
 
+# Pending IRQ Status bits reported at next Timer event
+IRQ_Pending = 0
+
+# Simulated time of the last transferred block (microseconds since transmitter enable)
+SimTime = 0
+
 
-## Open FILE file (store object into global FILE object)
+## Open FILE file (store object into global Writer object)
 #  @param name name of FILE file to open
 def openFILE(name):
-    global FILE
-    logging.info("Open data file (write mode): {}".format(name))
-    
-    FILE = open(name, 'w')
-
-
-def writeFILE(data):
-    global FILE
-    logging.info("Write FILE data")
-    if(SAMPLE_BITS == 8): # write each byte as an int
-        int8_vals = [x for x in frame]
-        FILE.writelines(["\t".join(str(x) for x in int8_vals), "\n"])
-    if(SAMPLE_BITS == 16):
-        byte_tuple = [x for x in zip(frame[::2], frame[1::2])]
-        byte_list = [x[0].to_bytes(1, 'big') + x[1].to_bytes(1, 'big') for x in byte_tuple]
-        int16_vals = [int.from_bytes(x, 'big') for x in byte_list]
-        FILE.writelines(["\t".join(str(x) for x in int16_vals), "\n"])
-    if(SAMPLE_BITS == 16):
-        byte_tuple = [x for x in zip(frame[::4], frame[1::4], frame[2::4], frame[3::4])]
-        byte_list = [x[0].to_bytes(1, 'big') + x[1].to_bytes(1, 'big') + x[2].to_bytes(1, 'big') + x[3].to_bytes(1, 'big') for x in byte_tuple]
-        int32_vals = [int.from_bytes(x, 'big') for x in byte_list]
-        FILE.writelines(["\t".join(str(x) for x in int32_vals), "\n"])
-
-
-## Close FILE file (global FILE object)
+    global Writer
+    logging.info("Open data file (write mode): %s", name)
+
+    Writer = vsi_sensor_data.BinaryWriter(name, CHANNELS, SAMPLE_BITS, SAMPLE_RATE, WRITER_QUEUE_DEPTH,
+                                          CAPTURE_TIMESTAMPS)
+
+
+## Close FILE file (global Writer object), flushes queued blocks
 def closeFILE():
-    global FILE
+    global Writer
     logging.info("Close FILE file")
-    FILE.close()
+    if Writer is not None:
+        Writer.close()
+        Writer = None
 
 
 ## Store data frames from global Data buffer
 #  @param block_size size of block to store (in bytes)
 def storeDataFrames(block_size):
-    global Data
+    global Data, OVERFLOW, IRQ_Pending, SimTime
     logging.info("Store data frames from data buffer")
-    writeFILE(Data)
+
+    # Each block is transferred at a Timer event, after the current interval
+    SimTime += Timer_Interval
+
+    if Writer is not None:
+        frame_size = CHANNELS * ((SAMPLE_BITS + 7) // 8)
+        if frame_size != 0:
+            # Only whole frames, the DMA block may be padded to a multiple of 4 bytes
+            block_size -= block_size % frame_size
+        if not Writer.write(Data[0:block_size], WRITER_BLOCK_ON_FULL, SimTime):
+            # Overflow: output sink does not keep up, block is dropped
+            OVERFLOW = (OVERFLOW + 1) & 0xFFFFFFFF
+            IRQ_Pending |= IRQ_Status_OVERFLOW_Msk
+            logging.warning("Overflow: output block dropped")
 
 
 ## Initialize
@@ -115,7 +135,7 @@ def rdIRQ():
     logging.info("Python function rdIRQ() called")
 
     value = IRQ_Status
-    logging.debug("Read interrupt request: {}".format(value))
+    logging.debug("Read interrupt request: %s", value)
 
     return value
 
@@ -128,7 +148,7 @@ def wrIRQ(value):
     logging.info("Python function wrIRQ() called")
 
     IRQ_Status = value
-    logging.debug("Write interrupt request: {}".format(value))
+    logging.debug("Write interrupt request: %s", value)
 
     return value
 
@@ -143,18 +163,22 @@ def wrTimer(index, value):
 
     if   index == 0:
         Timer_Control = value
-        logging.debug("Write Timer_Control: {}".format(value))
+        logging.debug("Write Timer_Control: %s", value)
     elif index == 1:
         Timer_Interval = value
-        logging.debug("Write Timer_Interval: {}".format(value))
+        logging.debug("Write Timer_Interval: %s", value)
 
     return value
 
 
 ## Timer event (called at Timer Overflow)
 def timerEvent():
+    global IRQ_Status, IRQ_Pending
     logging.info("Python function timerEvent() called")
 
+    IRQ_Status |= IRQ_Pending
+    IRQ_Pending = 0
+
 
 ## Write DMA registers (the VSI DMA Registers)
 #  @param index DMA register index (zero based)
@@ -166,7 +190,7 @@ def wrDMA(index, value):
 
     if   index == 0:
         DMA_Control = value
-        logging.debug("Write DMA_Control: {}".format(value))
+        logging.debug("Write DMA_Control: %s", value)
 
     return value
 
@@ -181,7 +205,7 @@ def rdDataDMA(size):
     n = min(len(Data), size)
     data = bytearray(size)
     data[0:n] = Data[0:n]
-    logging.debug("Read data ({} bytes)".format(size))
+    logging.debug("Read data (%s bytes)", size)
 
     return data
 
@@ -194,7 +218,7 @@ def wrDataDMA(data, size):
     logging.info("Python function wrDataDMA() called")
 
     Data = data
-    logging.debug("Write data ({} bytes)".format(size))
+    logging.debug("Write data (%s bytes)", size)
 
     storeDataFrames(size)
 
@@ -204,47 +228,54 @@ def wrDataDMA(data, size):
 ## Write CONTROL register (user register)
 #  @param value value to write (32-bit)
 def wrCONTROL(value):
-    global CONTROL
+    global CONTROL, SimTime
     if ((value ^ CONTROL) & CONTROL_ENABLE_Msk) != 0:
         if (value & CONTROL_ENABLE_Msk) != 0:
             logging.info("Enable Transmitter")
-            openFILE('test.txt')
+            SimTime = 0
+            openFILE(data_file)
         else:
             logging.info("Disable Transmitter")
             closeFILE()
     CONTROL = value
+    return value
 
 ## Write CHANNELS register (user register)
 #  @param value value to write (32-bit)
 def wrCHANNELS(value):
     global CHANNELS
     CHANNELS = value
-    logging.info("Number of channels: {}".format(value))
+    logging.info("Number of channels: %s", value)
+    return value
 
 ## Write SAMPLE_BITS register (user register)
 #  @param value value to write (32-bit)
 def wrSAMPLE_BITS(value):
     global SAMPLE_BITS
     SAMPLE_BITS = value
-    logging.info("Sample bits: {}".format(value))
+    logging.info("Sample bits: %s", value)
+    return value
 
 ## Write SAMPLE_RATE register (user register)
 #  @param value value to write (32-bit)
 def wrSAMPLE_RATE(value):
     global SAMPLE_RATE
     SAMPLE_RATE = value
-    logging.info("Sample rate: {}".format(value))
+    logging.info("Sample rate: %s", value)
+    return value
 
 
 ## Read user registers (the VSI User Registers)
 #  @param index user register index (zero based)
 #  @return value value read (32-bit)
 def rdRegs(index):
-    global Regs
     logging.info("Python function rdRegs() called")
 
-    value = Regs[index]
-    logging.debug("Read user register at index {}: {}".format(index, value))
+    if index < REG_NUM:
+        value = RegsRd[index]()
+    else:
+        value = Regs[index]
+    logging.debug("Read user register at index %s: %s", index, value)
 
     return value
 
@@ -257,20 +288,18 @@ def wrRegs(index, value):
     global Regs
     logging.info("Python function wrRegs() called")
 
-    if   index == 0:
-        wrCONTROL(value)
-    elif index == 1:
-        wrCHANNELS(value)
-    elif index == 2:
-        wrSAMPLE_BITS(value)
-    elif index == 3:
-        wrSAMPLE_RATE(value)
-
-    Regs[index] = value
-    logging.debug("Write user register at index {}: {}".format(index, value))
+    if index < REG_NUM:
+        value = RegsWr[index](value)
+    else:
+        Regs[index] = value
+    logging.debug("Write user register at index %s: %s", index, value)
 
     return value
 
 
+# User register dispatch tables (indexed by register index)
+RegsRd, RegsWr = sensor_regs.dispatch(globals())
+
+
 ## @}
 
@@ -0,0 +1,87 @@
+# Copyright (c) 2026 Arm Limited. All rights reserved.
+
+# Generated by vsi_regmap.py from sensor_regs.json, do not edit
+
+# Sensor Peripheral registers (VSI user registers)
+
+REG_NUM                   = 7           # Number of user registers
+REG_IDX_MAX               = 6           # Maximum user register index
+
+CONTROL_Idx               = 0           # Control receiver/transmitter
+CHANNELS_Idx              = 1           # Number of channels
+SAMPLE_BITS_Idx           = 2           # Sample number of bits (8..32)
+SAMPLE_RATE_Idx           = 3           # Sample rate (samples per second)
+UNDERFLOW_Idx             = 4           # Incomplete blocks (monotonic), read-only
+OVERFLOW_Idx              = 5           # Dropped blocks (monotonic), read-only
+INTERVAL_Idx              = 6           # Replay: interval to next block in us (0 = not timestamped), read-only
+
+# CONTROL register definitions
+CONTROL_ENABLE_Pos        = 0
+CONTROL_ENABLE_Msk        = 1<<0
+CONTROL_FREE_RUN_Pos      = 1
+CONTROL_FREE_RUN_Msk      = 1<<1
+
+# IRQ Status register definitions
+IRQ_Status_DATA_Msk       = 1<<0        # IRQ Status: data block transferred (VSI_STREAM_IRQ_BLOCK_Msk)
+IRQ_Status_OVERFLOW_Msk   = 1<<1        # IRQ Status: block dropped
+IRQ_Status_UNDERFLOW_Msk  = 1<<2        # IRQ Status: block incomplete
+IRQ_Status_Msk            = IRQ_Status_DATA_Msk | IRQ_Status_OVERFLOW_Msk | IRQ_Status_UNDERFLOW_Msk
+
+## Registers: (index, name, access)
+REGISTERS = (
+    (0, 'CONTROL', 'rw'),
+    (1, 'CHANNELS', 'rw'),
+    (2, 'SAMPLE_BITS', 'rw'),
+    (3, 'SAMPLE_RATE', 'rw'),
+    (4, 'UNDERFLOW', 'ro'),
+    (5, 'OVERFLOW', 'ro'),
+    (6, 'INTERVAL', 'ro'),
+)
+
+__all__ = (
+    'REG_NUM',
+    'REG_IDX_MAX',
+    'CONTROL_Idx',
+    'CHANNELS_Idx',
+    'SAMPLE_BITS_Idx',
+    'SAMPLE_RATE_Idx',
+    'UNDERFLOW_Idx',
+    'OVERFLOW_Idx',
+    'INTERVAL_Idx',
+    'CONTROL_ENABLE_Pos',
+    'CONTROL_ENABLE_Msk',
+    'CONTROL_FREE_RUN_Pos',
+    'CONTROL_FREE_RUN_Msk',
+    'IRQ_Status_DATA_Msk',
+    'IRQ_Status_OVERFLOW_Msk',
+    'IRQ_Status_UNDERFLOW_Msk',
+    'IRQ_Status_Msk',
+)
+
+
+## Build register dispatch tables for a model script
+#
+#  Register values are held in the model namespace (module globals) under the
+#  register name. Model functions rd<NAME>() and wr<NAME>(value) replace the
+#  default access; a write function stores the register and returns the value
+#  reported as written. Writes to read-only registers without write function
+#  leave the register unchanged.
+#  @param model model namespace (dict)
+#  @return (rd, wr) tuples of REG_NUM access functions indexed by register index
+def dispatch(model):
+    def reader(name):
+        return lambda: model[name]
+    def writer(name):
+        def write(value):
+            model[name] = value
+            return value
+        return write
+    def ignore(name):
+        return lambda value: model[name]
+    rd = []
+    wr = []
+    for index, name, access in REGISTERS:
+        model.setdefault(name, 0)
+        rd.append(model.get('rd' + name) or reader(name))
+        wr.append(model.get('wr' + name) or (ignore(name) if access == 'ro' else writer(name)))
+    return tuple(rd), tuple(wr)
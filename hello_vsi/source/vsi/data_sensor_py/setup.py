@@ -0,0 +1,29 @@
+# Copyright (c) 2026 Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the License); you may
+# not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an AS IS BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Build of the native VSI Sensor model core (optional, arm_vsi0.py falls back
+# to the Python implementation when the extension is not available).
+#
+# Build in this directory with the Python version used by the FVP:
+#   python setup.py build_ext --inplace
+
+from setuptools import setup, Extension
+
+setup(
+    name        = 'vsi_sensor_core',
+    description = 'Native core of the VSI Sensor Input model',
+    ext_modules = [ Extension('vsi_sensor_core', sources = ['vsi_sensor_core.c'], include_dirs = ['../data_sensor']) ]
+)
@@ -0,0 +1,484 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Native core of the VSI Sensor Input model (arm_vsi0.py)
+ *
+ * Implements the VSI callbacks (rdIRQ, wrIRQ, wrTimer, timerEvent, wrDMA,
+ * rdDataDMA, wrDataDMA, rdRegs, wrRegs) with the register semantics of the
+ * pure-Python model, so that the per-block callbacks run without executing
+ * Python code. Opening and closing data files stays in Python: the core calls
+ * back on_control(value) when the receiver is enabled or disabled, and the
+ * script then hands over the sample data with set_source(). At end of data
+ * the core calls back on_eof().
+ *
+ * Build (in this directory, with the Python used by the FVP):
+ *   python setup.py build_ext --inplace
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "sensor_regs.h"
+
+/* VSI user registers (register map in sensor_regs.h, generated from sensor_regs.json) */
+#define REGS_NUM                    64U
+
+/* Timestamped block record: timestamp (8 bytes), data size (4 bytes) */
+#define RECORD_SIZE                 12U
+
+/* Sensor model instance */
+typedef struct {
+  PyObject_HEAD
+  uint32_t   irq_status;                /* IRQ Status register */
+  uint32_t   irq_pending;               /* IRQ Status bits reported at next Timer event */
+  uint32_t   timer_control;             /* Timer Control register */
+  uint32_t   timer_interval;            /* Timer Interval register */
+  uint32_t   dma_control;               /* DMA Control register */
+  uint32_t   control;                   /* CONTROL register value last written */
+  uint32_t   regs[REGS_NUM];            /* User registers */
+  int        eof;                       /* End of data reached */
+  int        timestamped;               /* Source is a sequence of timestamped block records */
+  Py_buffer  source;                    /* Sample data (valid when source.obj != NULL) */
+  Py_ssize_t offset;                    /* Read offset into source */
+  uint64_t   blocks;                    /* Blocks delivered since set_source */
+  uint64_t   bytes;                     /* Bytes delivered since set_source */
+  PyObject  *on_control;                /* Called with CONTROL value when ENABLE changes */
+  PyObject  *on_eof;                    /* Called at end of data */
+} Sensor_t;
+
+/* Parse timestamped block record at offset (returns 0 when there is no complete record header) */
+static int Record (const Sensor_t *s, Py_ssize_t offset, uint64_t *timestamp, Py_ssize_t *start, Py_ssize_t *end) {
+  const uint8_t *p = (const uint8_t *)s->source.buf + offset;
+  uint64_t ts  = 0U;
+  uint32_t len = 0U;
+
+  if ((offset + (Py_ssize_t)RECORD_SIZE) > s->source.len) {
+    return 0;
+  }
+  for (uint32_t i = 0U; i < 8U; i++) {
+    ts |= (uint64_t)p[i] << (8U * i);
+  }
+  for (uint32_t i = 0U; i < 4U; i++) {
+    len |= (uint32_t)p[8U + i] << (8U * i);
+  }
+  *timestamp = ts;
+  *start     = offset + RECORD_SIZE;
+  *end       = ((s->source.len - *start) < (Py_ssize_t)len) ? s->source.len : (*start + (Py_ssize_t)len);
+  return 1;
+}
+
+/* Interval from timestamp to the record at offset (at least 1, 0 without next record) */
+static uint32_t Interval (const Sensor_t *s, uint64_t timestamp, Py_ssize_t offset) {
+  uint64_t   next;
+  Py_ssize_t start, end;
+
+  if (Record(s, offset, &next, &start, &end) == 0) {
+    return 0U;
+  }
+  if (next <= timestamp) {
+    return 1U;
+  }
+  next -= timestamp;
+  return (next > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)next;
+}
+
+/* Release sample data */
+static void ClearSource (Sensor_t *s) {
+  if (s->source.obj != NULL) {
+    PyBuffer_Release(&s->source);
+    s->source.obj = NULL;
+  }
+  s->regs[INTERVAL_Idx] = 0U;
+}
+
+/* Check number of positional arguments of fast call */
+static int CheckArgs (const char *name, Py_ssize_t nargs, Py_ssize_t expected) {
+  if (nargs != expected) {
+    PyErr_Format(PyExc_TypeError, "%s() takes %zd arguments (%zd given)", name, expected, nargs);
+    return 0;
+  }
+  return 1;
+}
+
+/* Call Python callback (errors are printed, the simulation continues) */
+static void Callback (PyObject *func, PyObject *arg) {
+  PyObject *ret;
+
+  if ((func == NULL) || (func == Py_None)) {
+    return;
+  }
+  ret = (arg != NULL) ? PyObject_CallOneArg(func, arg) : PyObject_CallNoArgs(func);
+  if (ret == NULL) {
+    PyErr_Print();
+  }
+  Py_XDECREF(ret);
+}
+
+/* Read next block of at most size bytes from source (start/length of data, 0 length at end of data) */
+static Py_ssize_t ReadBlock (Sensor_t *s, Py_ssize_t size, Py_ssize_t *start) {
+  uint64_t   timestamp;
+  Py_ssize_t end;
+
+  if (s->source.obj == NULL) {
+    return 0;
+  }
+
+  if (s->timestamped != 0) {
+    if (Record(s, s->offset, &timestamp, start, &end) == 0) {
+      s->regs[INTERVAL_Idx] = 0U;
+      return 0;
+    }
+    s->offset = end;
+    s->regs[INTERVAL_Idx] = Interval(s, timestamp, end);
+    /* Records larger than the block are truncated */
+    return ((end - *start) > size) ? size : (end - *start);
+  }
+
+  *start = s->offset;
+  end    = ((s->source.len - *start) < size) ? s->source.len : (*start + size);
+  s->offset = end;
+  return (end - *start);
+}
+
+
+static int Sensor_init (Sensor_t *self, PyObject *args, PyObject *kwds) {
+  static char *kwlist[] = { "on_control", "on_eof", NULL };
+  PyObject *on_control = Py_None;
+  PyObject *on_eof     = Py_None;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", kwlist, &on_control, &on_eof)) {
+    return -1;
+  }
+  Py_INCREF(on_control);
+  Py_XSETREF(self->on_control, on_control);
+  Py_INCREF(on_eof);
+  Py_XSETREF(self->on_eof, on_eof);
+  return 0;
+}
+
+static void Sensor_dealloc (Sensor_t *self) {
+  ClearSource(self);
+  Py_XDECREF(self->on_control);
+  Py_XDECREF(self->on_eof);
+  Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+/* rdIRQ(): read IRQ Status register */
+static PyObject *Sensor_rdIRQ (Sensor_t *self, PyObject *Py_UNUSED(arg)) {
+  return PyLong_FromUnsignedLong(self->irq_status);
+}
+
+/* wrIRQ(value): write IRQ Status register (no data IRQ at end of data) */
+static PyObject *Sensor_wrIRQ (Sensor_t *self, PyObject *arg) {
+  uint32_t value = (uint32_t)PyLong_AsUnsignedLongMask(arg);
+
+  if (PyErr_Occurred()) {
+    return NULL;
+  }
+  if (self->eof != 0) {
+    value &= ~IRQ_Status_DATA_Msk;
+  }
+  self->irq_status = value;
+  return PyLong_FromUnsignedLong(value);
+}
+
+/* wrTimer(index, value): write Timer registers */
+static PyObject *Sensor_wrTimer (Sensor_t *self, PyObject *const *args, Py_ssize_t nargs) {
+  Py_ssize_t index;
+  uint32_t   value;
+
+  if (CheckArgs("wrTimer", nargs, 2) == 0) {
+    return NULL;
+  }
+  index = PyLong_AsSsize_t(args[0]);
+  value = (uint32_t)PyLong_AsUnsignedLongMask(args[1]);
+  if (PyErr_Occurred()) {
+    return NULL;
+  }
+  if (index == 0) {
+    self->timer_control = value;
+  } else if (index == 1) {
+    self->timer_interval = value;
+  }
+  return PyLong_FromUnsignedLong(value);
+}
+
+/* timerEvent(): report pending IRQ Status bits */
+static PyObject *Sensor_timerEvent (Sensor_t *self, PyObject *Py_UNUSED(arg)) {
+  self->irq_status  |= self->irq_pending;
+  self->irq_pending  = 0U;
+  Py_RETURN_NONE;
+}
+
+/* wrDMA(index, value): write DMA registers */
+static PyObject *Sensor_wrDMA (Sensor_t *self, PyObject *const *args, Py_ssize_t nargs) {
+  Py_ssize_t index;
+  uint32_t   value;
+
+  if (CheckArgs("wrDMA", nargs, 2) == 0) {
+    return NULL;
+  }
+  index = PyLong_AsSsize_t(args[0]);
+  value = (uint32_t)PyLong_AsUnsignedLongMask(args[1]);
+  if (PyErr_Occurred()) {
+    return NULL;
+  }
+  if (index == 0) {
+    self->dma_control = value;
+  }
+  return PyLong_FromUnsignedLong(value);
+}
+
+/* rdDataDMA(size): deliver next block of sensor frames (padded to size, None at end of data) */
+static PyObject *Sensor_rdDataDMA (Sensor_t *self, PyObject *arg) {
+  Py_ssize_t size = PyLong_AsSsize_t(arg);
+  Py_ssize_t frame_size, block, start = 0, len;
+  PyObject  *data;
+
+  if (PyErr_Occurred()) {
+    return NULL;
+  }
+  if (size < 0) {
+    size = 0;
+  }
+
+  frame_size = (Py_ssize_t)self->regs[CHANNELS_Idx] * (((Py_ssize_t)self->regs[SAMPLE_BITS_Idx] + 7) / 8);
+  if (frame_size == 0) {
+    PyErr_SetString(PyExc_ZeroDivisionError, "sensor frame size is 0 (CHANNELS or SAMPLE_BITS not set)");
+    return NULL;
+  }
+  block = (size / frame_size) * frame_size;
+
+  len = ReadBlock(self, block, &start);
+  if (len == 0) {
+    self->eof = 1;
+    self->regs[CONTROL_Idx] = 0U;
+    Callback(self->on_eof, NULL);
+    Py_RETURN_NONE;
+  }
+  self->blocks += 1U;
+  self->bytes  += (uint64_t)len;
+
+  /* Underflow: sensor data ran out within the block (rest of block is padding) */
+  if (len < block) {
+    self->regs[UNDERFLOW_Idx] += 1U;
+    self->irq_pending     |= IRQ_Status_UNDERFLOW_Msk;
+  }
+
+  data = PyByteArray_FromStringAndSize(NULL, size);
+  if (data == NULL) {
+    return NULL;
+  }
+  memcpy(PyByteArray_AS_STRING(data), (const uint8_t *)self->source.buf + start, (size_t)((len < size) ? len : size));
+  if (len < size) {
+    memset(PyByteArray_AS_STRING(data) + len, 0, (size_t)(size - len));
+  }
+  return data;
+}
+
+/* wrDataDMA(data, size): data written by DMA M2P transfer is ignored by the sensor input */
+static PyObject *Sensor_wrDataDMA (Sensor_t *self, PyObject *const *args, Py_ssize_t nargs) {
+  (void)self;
+  (void)args;
+  if (CheckArgs("wrDataDMA", nargs, 2) == 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* rdRegs(index): read user register */
+static PyObject *Sensor_rdRegs (Sensor_t *self, PyObject *arg) {
+  Py_ssize_t index = PyLong_AsSsize_t(arg);
+
+  if (PyErr_Occurred()) {
+    return NULL;
+  }
+  if ((index < 0) || (index >= (Py_ssize_t)REGS_NUM)) {
+    PyErr_SetString(PyExc_IndexError, "user register index out of range");
+    return NULL;
+  }
+  return PyLong_FromUnsignedLong(self->regs[index]);
+}
+
+/* wrRegs(index, value): write user register (returns the register value) */
+static PyObject *Sensor_wrRegs (Sensor_t *self, PyObject *const *args, Py_ssize_t nargs) {
+  Py_ssize_t index;
+  uint32_t   value;
+  PyObject  *obj;
+
+  if (CheckArgs("wrRegs", nargs, 2) == 0) {
+    return NULL;
+  }
+  index = PyLong_AsSsize_t(args[0]);
+  value = (uint32_t)PyLong_AsUnsignedLongMask(args[1]);
+  if (PyErr_Occurred()) {
+    return NULL;
+  }
+  if ((index < 0) || (index >= (Py_ssize_t)REGS_NUM)) {
+    PyErr_SetString(PyExc_IndexError, "user register index out of range");
+    return NULL;
+  }
+
+  switch (index) {
+    case CONTROL_Idx:
+      if (((value ^ self->control) & CONTROL_ENABLE_Msk) != 0U) {
+        if ((value & CONTROL_ENABLE_Msk) == 0U) {
+          /* Receiver disabled: release data before the script closes the file */
+          ClearSource(self);
+        }
+        obj = PyLong_FromUnsignedLong(value);
+        if (obj == NULL) {
+          return NULL;
+        }
+        Callback(self->on_control, obj);
+        Py_DECREF(obj);
+      }
+      self->control = value;
+      break;
+    case UNDERFLOW_Idx:
+    case OVERFLOW_Idx:
+    case INTERVAL_Idx:
+      /* Read-only */
+      return PyLong_FromUnsignedLong(self->regs[index]);
+    default:
+      break;
+  }
+
+  self->regs[index] = value;
+  return PyLong_FromUnsignedLong(value);
+}
+
+/* set_source(data, offset=0, timestamped=False): set sample data of enabled receiver */
+static PyObject *Sensor_set_source (Sensor_t *self, PyObject *args, PyObject *kwds) {
+  static char *kwlist[] = { "data", "offset", "timestamped", NULL };
+  PyObject  *obj;
+  Py_ssize_t offset      = 0;
+  int        timestamped = 0;
+  uint64_t   timestamp;
+  Py_ssize_t start, end;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|np", kwlist, &obj, &offset, &timestamped)) {
+    return NULL;
+  }
+  ClearSource(self);
+  if (PyObject_GetBuffer(obj, &self->source, PyBUF_SIMPLE) != 0) {
+    self->source.obj = NULL;
+    return NULL;
+  }
+  if ((offset < 0) || (offset > self->source.len)) {
+    offset = self->source.len;
+  }
+  self->offset      = offset;
+  self->timestamped = timestamped;
+  self->eof         = 0;
+  self->blocks      = 0U;
+  self->bytes       = 0U;
+
+  /* Interval between the first two blocks, known before the first read */
+  if ((timestamped != 0) && (Record(self, offset, &timestamp, &start, &end) != 0)) {
+    self->regs[INTERVAL_Idx] = Interval(self, timestamp, end);
+  }
+  Py_RETURN_NONE;
+}
+
+/* clear_source(): release sample data */
+static PyObject *Sensor_clear_source (Sensor_t *self, PyObject *Py_UNUSED(arg)) {
+  ClearSource(self);
+  Py_RETURN_NONE;
+}
+
+static PyObject *Sensor_get_blocks (Sensor_t *self, void *closure) {
+  (void)closure;
+  return PyLong_FromUnsignedLongLong(self->blocks);
+}
+
+static PyObject *Sensor_get_bytes (Sensor_t *self, void *closure) {
+  (void)closure;
+  return PyLong_FromUnsignedLongLong(self->bytes);
+}
+
+static PyObject *Sensor_get_eof (Sensor_t *self, void *closure) {
+  (void)closure;
+  return PyBool_FromLong(self->eof);
+}
+
+/* Fast call and keyword methods are cast through void (*)(void) to PyCFunction */
+static PyMethodDef Sensor_methods[] = {
+  { "rdIRQ",         (PyCFunction)Sensor_rdIRQ,                         METH_NOARGS,                  "Read IRQ Status register" },
+  { "wrIRQ",         (PyCFunction)Sensor_wrIRQ,                         METH_O,                       "Write IRQ Status register" },
+  { "wrTimer",       (PyCFunction)(void (*)(void))Sensor_wrTimer,       METH_FASTCALL,                "Write Timer registers" },
+  { "timerEvent",    (PyCFunction)Sensor_timerEvent,                    METH_NOARGS,                  "Timer event" },
+  { "wrDMA",         (PyCFunction)(void (*)(void))Sensor_wrDMA,         METH_FASTCALL,                "Write DMA registers" },
+  { "rdDataDMA",     (PyCFunction)Sensor_rdDataDMA,                     METH_O,                       "Read data for DMA P2M transfer" },
+  { "wrDataDMA",     (PyCFunction)(void (*)(void))Sensor_wrDataDMA,     METH_FASTCALL,                "Write data of DMA M2P transfer" },
+  { "rdRegs",        (PyCFunction)Sensor_rdRegs,                        METH_O,                       "Read user register" },
+  { "wrRegs",        (PyCFunction)(void (*)(void))Sensor_wrRegs,        METH_FASTCALL,                "Write user register" },
+  { "set_source",    (PyCFunction)(void (*)(void))Sensor_set_source,    METH_VARARGS | METH_KEYWORDS, "Set sample data (bytes-like, offset, timestamped)" },
+  { "clear_source",  (PyCFunction)Sensor_clear_source,                  METH_NOARGS,                  "Release sample data" },
+  { NULL, NULL, 0, NULL }
+};
+
+static PyGetSetDef Sensor_getset[] = {
+  { "blocks", (getter)Sensor_get_blocks, NULL, "Blocks delivered since set_source", NULL },
+  { "bytes",  (getter)Sensor_get_bytes,  NULL, "Bytes delivered since set_source",  NULL },
+  { "eof",    (getter)Sensor_get_eof,    NULL, "End of data reached",               NULL },
+  { NULL, NULL, NULL, NULL, NULL }
+};
+
+static PyTypeObject Sensor_Type = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  .tp_name      = "vsi_sensor_core.Sensor",
+  .tp_doc       = "VSI Sensor Input model (on_control=None, on_eof=None)",
+  .tp_basicsize = sizeof(Sensor_t),
+  .tp_flags     = Py_TPFLAGS_DEFAULT,
+  .tp_new       = PyType_GenericNew,
+  .tp_init      = (initproc)Sensor_init,
+  .tp_dealloc   = (destructor)Sensor_dealloc,
+  .tp_methods   = Sensor_methods,
+  .tp_getset    = Sensor_getset,
+};
+
+static struct PyModuleDef vsi_sensor_core_module = {
+  PyModuleDef_HEAD_INIT,
+  .m_name = "vsi_sensor_core",
+  .m_doc  = "Native core of the VSI Sensor Input model",
+  .m_size = -1,
+};
+
+PyMODINIT_FUNC PyInit_vsi_sensor_core (void) {
+  PyObject *m;
+
+  if (PyType_Ready(&Sensor_Type) < 0) {
+    return NULL;
+  }
+  m = PyModule_Create(&vsi_sensor_core_module);
+  if (m == NULL) {
+    return NULL;
+  }
+  Py_INCREF(&Sensor_Type);
+  if (PyModule_AddObject(m, "Sensor", (PyObject *)&Sensor_Type) < 0) {
+    Py_DECREF(&Sensor_Type);
+    Py_DECREF(m);
+    return NULL;
+  }
+  return m;
+}
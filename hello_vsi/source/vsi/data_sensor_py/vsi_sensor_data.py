@@ -0,0 +1,367 @@
+# Copyright (c) 2026 Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the License); you may
+# not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an AS IS BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Python VSI Sensor data file module
+#
+# Binary sensor data file layout (all fields little-endian):
+#   Offset  Size  Field
+#   0       4     Magic 'VSID'
+#   4       2     Format version
+#   6       2     Header size in bytes (offset of sample data)
+#   8       2     Number of channels
+#   10      2     Sample number of bits (8..32)
+#   12      4     Sample rate (samples per second)
+#   16      ..    Interleaved samples, (sample_bits + 7) // 8 bytes each
+#
+# Format version 2 (timestamped capture) has the same header followed by one
+# record per block instead of a flat sample stream:
+#   0       8     Block timestamp (simulated time in microseconds)
+#   8       4     Block data size in bytes
+#   12      ..    Interleaved samples of the block
+
+try:
+    import argparse
+    import logging
+    import mmap
+    import os
+    import queue
+    import struct
+    import threading
+except ImportError as err:
+    print(f"VSI:Sensor:ImportError: {err}")
+    raise
+
+# NumPy is optional, struct is used for packing samples when not available
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+
+HEADER_MAGIC   = b'VSID'
+HEADER_VERSION = 1
+HEADER_VERSION_TIMESTAMPED = 2
+HEADER_FORMAT  = '<4sHHHHI'
+HEADER_SIZE    = struct.calcsize(HEADER_FORMAT)
+RECORD_FORMAT  = '<QI'
+RECORD_SIZE    = struct.calcsize(RECORD_FORMAT)
+
+# Sample container types by (sample size in bytes, signed)
+struct_codes   = { (1, False): 'B', (1, True): 'b',
+                   (2, False): 'H', (2, True): 'h',
+                   (4, False): 'I', (4, True): 'i' }
+numpy_types    = { (1, False): '<u1', (1, True): '<i1',
+                   (2, False): '<u2', (2, True): '<i2',
+                   (4, False): '<u4', (4, True): '<i4' }
+
+
+## Check if file is a binary sensor data file
+#  @param name file name
+#  @return True when file starts with the binary header magic
+def isBinaryFile(name):
+    try:
+        with open(name, 'rb') as f:
+            return f.read(len(HEADER_MAGIC)) == HEADER_MAGIC
+    except OSError:
+        return False
+
+
+## Binary sensor data file reader
+#
+#  Sample data is memory-mapped and handed out as slices, without parsing.
+#  Timestamped files are read one block record at a time; interval holds the
+#  time from the block last read to the next one (microseconds, at least 1,
+#  0 after the last block).
+class BinaryReader:
+    def __init__(self, name):
+        self.file = open(name, 'rb')
+        try:
+            self.mm = mmap.mmap(self.file.fileno(), 0, access=mmap.ACCESS_READ)
+        except ValueError:
+            self.file.close()
+            raise ValueError(f"Empty sensor data file: {name}")
+
+        if len(self.mm) < HEADER_SIZE:
+            self.close()
+            raise ValueError(f"Truncated sensor data file header: {name}")
+
+        magic, version, header_size, channels, sample_bits, sample_rate = \
+            struct.unpack_from(HEADER_FORMAT, self.mm, 0)
+        if (magic != HEADER_MAGIC) or (version not in (HEADER_VERSION, HEADER_VERSION_TIMESTAMPED)) or \
+           (header_size < HEADER_SIZE):
+            self.close()
+            raise ValueError(f"Unsupported sensor data file: {name}")
+
+        self.channels    = channels
+        self.sample_bits = sample_bits
+        self.sample_rate = sample_rate
+        self.offset      = header_size
+        self.size        = len(self.mm)
+        self.timestamped = (version == HEADER_VERSION_TIMESTAMPED)
+        self.timestamp   = None
+        self.interval    = 0
+        if self.timestamped:
+            # Interval between the first two blocks, known before the first read
+            first = self._record(self.offset)
+            if first is not None:
+                self.interval = self._interval(first[0], self._record(first[2]))
+
+    ## Parse block record header
+    #  @param offset file offset of record
+    #  @return (timestamp, data offset, next record offset), None at end of file
+    def _record(self, offset):
+        if (offset + RECORD_SIZE) > self.size:
+            return None
+        timestamp, length = struct.unpack_from(RECORD_FORMAT, self.mm, offset)
+        start = offset + RECORD_SIZE
+        return (timestamp, start, min(start + length, self.size))
+
+    ## Interval from timestamp to next record (at least 1, 0 without next record)
+    def _interval(self, timestamp, record):
+        if record is None:
+            return 0
+        return min(max(record[0] - timestamp, 1), 0xFFFFFFFF)
+
+    ## Read next block of data
+    #  @param size maximum number of bytes to read
+    #  @return data bytes (empty at end of file)
+    def read(self, size):
+        if self.timestamped:
+            record = self._record(self.offset)
+            if record is None:
+                self.interval = 0
+                return b''
+            self.timestamp, start, end = record
+            self.offset   = end
+            self.interval = self._interval(self.timestamp, self._record(end))
+            if (end - start) > size:
+                logging.warning("Block record of {} bytes truncated to {} bytes".format(end - start, size))
+                end = start + size
+            return self.mm[start:end]
+
+        start = self.offset
+        end   = min(start + size, self.size)
+        self.offset = end
+        return self.mm[start:end]
+
+    def close(self):
+        if self.mm is not None:
+            self.mm.close()
+            self.mm = None
+        self.file.close()
+
+
+## Text sensor data file reader
+#
+#  Samples are whitespace separated integers, parsed once when the file is
+#  opened. Each block is packed into little-endian samples of the configured
+#  width in a single operation.
+class TextReader:
+    def __init__(self, name, sample_bits):
+        with open(name, 'r') as f:
+            tokens = f.read().split()
+        if np is not None:
+            self.samples = np.array(tokens, dtype=np.int64)
+            self.signed  = bool(len(self.samples) != 0 and self.samples.min() < 0)
+        else:
+            self.samples = [int(x) for x in tokens]
+            self.signed  = any(x < 0 for x in self.samples)
+        self.sample_bits = sample_bits
+        self.sample_size = (sample_bits + 7) // 8
+        self.index       = 0
+        self.size        = os.path.getsize(name)
+
+    ## Read next block of data
+    #  @param size maximum number of bytes to read
+    #  @return data bytes (empty at end of file)
+    def read(self, size):
+        n = size // self.sample_size
+        samples = self.samples[self.index:(self.index + n)]
+        self.index += len(samples)
+        return packSamples(samples, self.sample_bits, self.signed)
+
+    def close(self):
+        self.samples = None
+
+
+## Write binary sensor data file
+#  @param name file name
+#  @param data raw interleaved little-endian samples (bytes-like)
+#  @param channels number of channels
+#  @param sample_bits sample number of bits
+#  @param sample_rate sample rate (samples per second)
+def writeBinaryFile(name, data, channels, sample_bits, sample_rate):
+    header = struct.pack(HEADER_FORMAT, HEADER_MAGIC, HEADER_VERSION, HEADER_SIZE,
+                         channels, sample_bits, sample_rate)
+    with open(name, 'wb') as f:
+        f.write(header)
+        f.write(data)
+
+
+## Binary sensor data file writer
+#
+#  Blocks are copied into a bounded queue and written to file by a background
+#  thread, so the caller only blocks when the writer falls behind by more than
+#  queue_depth blocks. With timestamps each block is written as a record with
+#  its timestamp (format version 2).
+class BinaryWriter:
+    def __init__(self, name, channels, sample_bits, sample_rate, queue_depth=64, timestamps=False):
+        version = HEADER_VERSION_TIMESTAMPED if timestamps else HEADER_VERSION
+        self.file = open(name, 'wb')
+        self.file.write(struct.pack(HEADER_FORMAT, HEADER_MAGIC, version, HEADER_SIZE,
+                                    channels, sample_bits, sample_rate))
+        self.timestamps = timestamps
+        self.size   = HEADER_SIZE
+        self.queue  = queue.Queue(maxsize=queue_depth)
+        self.thread = threading.Thread(target=self._run, name="VSI sensor writer", daemon=True)
+        self.thread.start()
+
+    def _run(self):
+        while True:
+            data = self.queue.get()
+            if data is None:
+                break
+            self.file.write(data)
+            self.size += len(data)
+
+    ## Queue block of data for writing
+    #  @param data raw interleaved little-endian samples (bytes-like, copied)
+    #  @param block wait for space when the queue is full
+    #  @param timestamp block timestamp in microseconds (timestamped files)
+    #  @return False if the queue was full and the block was not queued
+    def write(self, data, block=True, timestamp=0):
+        if self.timestamps:
+            data = struct.pack(RECORD_FORMAT, timestamp, len(data)) + bytes(data)
+        try:
+            self.queue.put(bytes(data), block)
+        except queue.Full:
+            return False
+        return True
+
+    ## Flush queued blocks and close file
+    def close(self):
+        if self.thread is not None:
+            self.queue.put(None)
+            self.thread.join()
+            self.thread = None
+        self.file.close()
+
+
+## Pack integer samples into little-endian raw sample data
+#  @param samples sequence (or NumPy array) of integer samples
+#  @param sample_bits sample number of bits (8..32)
+#  @param signed pack as signed samples (detected from samples when None)
+#  @return data packed samples (bytes)
+def packSamples(samples, sample_bits, signed=None):
+    sample_size = (sample_bits + 7) // 8
+    # 24-bit samples are packed as 32-bit and the most significant byte is dropped
+    container   = 4 if sample_size == 3 else sample_size
+    n           = len(samples)
+
+    if np is not None:
+        samples = np.asarray(samples)
+        if signed is None:
+            signed = bool(n != 0 and samples.min() < 0)
+        data = samples.astype(numpy_types[(container, signed)])
+        if sample_size == 3:
+            return data.view(np.uint8).reshape(-1, 4)[:, 0:3].tobytes()
+        return data.tobytes()
+
+    if signed is None:
+        signed = any(x < 0 for x in samples)
+    data = struct.pack(f'<{n}{struct_codes[(container, signed)]}', *samples)
+    if sample_size == 3:
+        packed = bytearray(n * 3)
+        packed[0::3] = data[0::4]
+        packed[1::3] = data[1::4]
+        packed[2::3] = data[2::4]
+        return bytes(packed)
+    return data
+
+
+## Unpack little-endian raw sample data into integer samples
+#  @param data packed samples (bytes-like)
+#  @param sample_bits sample number of bits (8..32)
+#  @param signed unpack as signed samples
+#  @return samples list (or NumPy array) of integer samples
+def unpackSamples(data, sample_bits, signed=False):
+    sample_size = (sample_bits + 7) // 8
+    n           = len(data) // sample_size
+    data        = data[0:(n * sample_size)]
+
+    # 24-bit samples are expanded to 32-bit with the sign (or zero) extension byte
+    if sample_size == 3:
+        expanded = bytearray(n * 4)
+        expanded[0::4] = data[0::3]
+        expanded[1::4] = data[1::3]
+        expanded[2::4] = data[2::3]
+        if signed:
+            expanded[3::4] = bytes(0xFF if (b & 0x80) else 0x00 for b in data[2::3])
+        data        = expanded
+        sample_size = 4
+
+    if np is not None:
+        return np.frombuffer(data, dtype=numpy_types[(sample_size, signed)])
+    return list(struct.unpack(f'<{n}{struct_codes[(sample_size, signed)]}', data))
+
+
+## Export binary sensor data file to CSV (one row per frame, one column per channel)
+#  @param src binary sensor data file
+#  @param dst CSV file
+#  @param signed interpret samples as signed
+def exportCSV(src, dst, signed=False):
+    reader  = BinaryReader(src)
+    data    = bytearray()
+    while True:
+        block = reader.read(reader.size)
+        if len(block) == 0:
+            break
+        data += block
+    samples = unpackSamples(data, reader.sample_bits, signed)
+    frames  = len(samples) // reader.channels
+    with open(dst, 'w') as f:
+        f.write(",".join(f"ch{c}" for c in range(reader.channels)) + "\n")
+        for i in range(0, frames * reader.channels, reader.channels):
+            f.write(",".join(str(int(x)) for x in samples[i:(i + reader.channels)]) + "\n")
+    reader.close()
+    logging.info(f"Exported {frames} frames from {src} to {dst}")
+
+
+## Convert text sensor data file (whitespace separated integers) to binary format
+def convertTextFile(src, dst, channels, sample_bits, sample_rate):
+    reader = TextReader(src, sample_bits)
+    writeBinaryFile(dst, packSamples(reader.samples, sample_bits, reader.signed), channels, sample_bits, sample_rate)
+    logging.info(f"Converted {len(reader.samples)} samples from {src} to {dst}")
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(description="Convert text sensor data to VSI binary sensor data file, or export it to CSV")
+    parser.add_argument("src", help="Input text file (whitespace separated integer samples), binary file with --csv")
+    parser.add_argument("dst", help="Output binary file, CSV file with --csv")
+    parser.add_argument("--csv", action="store_true", help="Export binary sensor data file to CSV")
+    parser.add_argument("--signed", action="store_true", help="Export samples as signed values (with --csv)")
+    parser.add_argument("--channels", type=int, default=1, help="Number of channels (default: 1)")
+    parser.add_argument("--bits", type=int, default=8, help="Sample number of bits (default: 8)")
+    parser.add_argument("--rate", type=int, default=20, help="Sample rate (default: 20)")
+    return parser.parse_args()
+
+
+if __name__ == '__main__':
+    args = parse_arguments()
+    if args.csv:
+        exportCSV(args.src, args.dst, args.signed)
+    else:
+        convertTextFile(args.src, args.dst, args.channels, args.bits, args.rate)
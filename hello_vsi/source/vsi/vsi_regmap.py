@@ -0,0 +1,260 @@
+# Copyright (c) 2026 Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the License); you may
+# not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an AS IS BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# VSI user register map generator
+#
+# Generates from one register description (JSON) the C header used by the
+# driver and the Python module used by the VSI model script, so that both
+# sides share the register indices, bit fields and IRQ Status bits.
+#
+# Register description:
+#   {
+#     "peripheral": "Sensor",                    Name used in comments
+#     "c_prefix":   "",                          Prefix of C names (optional)
+#     "registers": [                             User registers, index 0..N-1
+#       { "name": "CONTROL", "index": 0, "access": "rw" | "ro",
+#         "description": "...",
+#         "fields": [ { "name": "ENABLE", "bit": 0, "width": 1,
+#                       "description": "...",
+#                       "values": { "Input": 0, "Output": 1 } } ] }
+#     ],
+#     "irq": [ { "name": "DATA", "bit": 0, "description": "..." } ]
+#   }
+#
+# Generated names (C names with c_prefix):
+#   <REG>_Idx, <REG> (C: Regs[<REG>_Idx]), <REG>_<FIELD>_Pos/_Msk,
+#   <REG>_<VALUE>, IRQ_Status_<BIT>_Pos/_Msk, IRQ_Status_Msk
+#
+# Usage:
+#   python vsi_regmap.py sensor_regs.json --header data_sensor/sensor_regs.h --python data_sensor_py/sensor_regs.py
+#   (--check compares instead of writing and fails when outputs are out of date)
+
+try:
+    import argparse
+    import json
+    import os
+    import sys
+except ImportError as err:
+    print(f"VSI:RegMap:ImportError: {err}")
+    raise
+
+
+COPYRIGHT = "Copyright (c) 2026 Arm Limited. All rights reserved."
+
+
+## Load and validate register description
+#  @param name description file name
+#  @return description (dict)
+def load(name):
+    with open(name, 'r') as f:
+        desc = json.load(f)
+
+    regs = sorted(desc['registers'], key=lambda r: r['index'])
+    if [r['index'] for r in regs] != list(range(len(regs))):
+        raise ValueError(f"{name}: register indices must be contiguous from 0")
+    for reg in regs:
+        if reg.get('access', 'rw') not in ('rw', 'ro'):
+            raise ValueError(f"{name}: {reg['name']}: access must be 'rw' or 'ro'")
+        used = 0
+        for field in reg.get('fields', []):
+            mask = ((1 << field.get('width', 1)) - 1) << field['bit']
+            if (used & mask) != 0 or mask > 0xFFFFFFFF:
+                raise ValueError(f"{name}: {reg['name']}_{field['name']}: overlapping or out of range bits")
+            used |= mask
+    desc['registers'] = regs
+    desc.setdefault('c_prefix', '')
+    desc.setdefault('irq', [])
+    return desc
+
+
+## Field mask value as C/Python literal
+def maskLiteral(width, c):
+    value = (1 << width) - 1
+    literal = f"0x{value:X}" if width > 1 else "1"
+    return (literal + "UL") if c else literal
+
+
+## Generate C header
+#  @param desc register description
+#  @param source description file name (for the header comment)
+#  @param guard include guard name
+#  @return header text
+def genHeader(desc, source, guard):
+    p     = desc['c_prefix']
+    lines = []
+
+    def define(name, value, comment=None):
+        text = f"#define {name:<32}{value}"
+        if comment:
+            text = f"{text:<72}/* {comment} */"
+        lines.append(text)
+
+    lines += [ "/*", f" * {COPYRIGHT}", " */", "",
+               f"/* Generated by vsi_regmap.py from {source}, do not edit */", "",
+               f"#ifndef {guard}", f"#define {guard}", "",
+               f"/* {desc['peripheral']} Peripheral registers (VSI user registers) */" ]
+    for reg in desc['registers']:
+        access = ", read-only" if reg.get('access', 'rw') == 'ro' else ""
+        define(f"{p}{reg['name']}_Idx", f"{reg['index']}U")
+        define(f"{p}{reg['name']}", f"Regs[{p}{reg['name']}_Idx]", f"{reg['description']}{access}")
+
+    for reg in desc['registers']:
+        if not reg.get('fields'):
+            continue
+        lines += [ "", f"/* {desc['peripheral']} {reg['name']} register definitions */" ]
+        for field in reg['fields']:
+            name  = f"{p}{reg['name']}_{field['name']}"
+            width = field.get('width', 1)
+            define(f"{name}_Pos", f"{field['bit']}U", field.get('description'))
+            define(f"{name}_Msk", f"({maskLiteral(width, True)} << {name}_Pos)")
+            for value_name, value in field.get('values', {}).items():
+                define(f"{p}{reg['name']}_{value_name}", f"({value}UL << {name}_Pos)")
+
+    if desc['irq']:
+        lines += [ "", f"/* {desc['peripheral']} IRQ Status register definitions */" ]
+        for bit in desc['irq']:
+            name = f"{p}IRQ_Status_{bit['name']}"
+            define(f"{name}_Pos", f"{bit['bit']}U", bit.get('description'))
+            define(f"{name}_Msk", f"(1UL << {name}_Pos)")
+        masks = [ f"{p}IRQ_Status_{bit['name']}_Msk" for bit in desc['irq'] ]
+        define(f"{p}IRQ_Status_Msk", "(" + " | ".join(masks) + ")")
+
+    lines += [ "", f"#endif /* {guard} */", "" ]
+    return "\n".join(lines)
+
+
+## Register dispatch (copied into the generated Python module)
+DISPATCH = '''
+
+## Build register dispatch tables for a model script
+#
+#  Register values are held in the model namespace (module globals) under the
+#  register name. Model functions rd<NAME>() and wr<NAME>(value) replace the
+#  default access; a write function stores the register and returns the value
+#  reported as written. Writes to read-only registers without write function
+#  leave the register unchanged.
+#  @param model model namespace (dict)
+#  @return (rd, wr) tuples of REG_NUM access functions indexed by register index
+def dispatch(model):
+    def reader(name):
+        return lambda: model[name]
+    def writer(name):
+        def write(value):
+            model[name] = value
+            return value
+        return write
+    def ignore(name):
+        return lambda value: model[name]
+    rd = []
+    wr = []
+    for index, name, access in REGISTERS:
+        model.setdefault(name, 0)
+        rd.append(model.get('rd' + name) or reader(name))
+        wr.append(model.get('wr' + name) or (ignore(name) if access == 'ro' else writer(name)))
+    return tuple(rd), tuple(wr)
+'''
+
+
+## Generate Python module
+#  @param desc register description
+#  @param source description file name (for the module comment)
+#  @return module text
+def genPython(desc, source):
+    regs  = desc['registers']
+    lines = [ f"# {COPYRIGHT}", "",
+              f"# Generated by vsi_regmap.py from {source}, do not edit", "",
+              f"# {desc['peripheral']} Peripheral registers (VSI user registers)", "" ]
+    exports = []
+
+    def assign(name, value, comment=None):
+        exports.append(name)
+        text = f"{name:<26}= {value}"
+        if comment:
+            text = f"{text:<40}# {comment}"
+        lines.append(text)
+
+    assign("REG_NUM", len(regs), "Number of user registers")
+    assign("REG_IDX_MAX", len(regs) - 1, "Maximum user register index")
+    lines.append("")
+    for reg in regs:
+        access = ", read-only" if reg.get('access', 'rw') == 'ro' else ""
+        assign(f"{reg['name']}_Idx", reg['index'], f"{reg['description']}{access}")
+
+    for reg in regs:
+        if not reg.get('fields'):
+            continue
+        lines += [ "", f"# {reg['name']} register definitions" ]
+        for field in reg['fields']:
+            name  = f"{reg['name']}_{field['name']}"
+            width = field.get('width', 1)
+            assign(f"{name}_Pos", field['bit'])
+            assign(f"{name}_Msk", f"{maskLiteral(width, False)}<<{field['bit']}")
+            for value_name, value in field.get('values', {}).items():
+                assign(f"{reg['name']}_{value_name}", f"{value}<<{field['bit']}")
+
+    if desc['irq']:
+        lines += [ "", "# IRQ Status register definitions" ]
+        for bit in desc['irq']:
+            assign(f"IRQ_Status_{bit['name']}_Msk", f"1<<{bit['bit']}", bit.get('description'))
+        assign("IRQ_Status_Msk", " | ".join(f"IRQ_Status_{bit['name']}_Msk" for bit in desc['irq']))
+
+    lines += [ "", "## Registers: (index, name, access)", "REGISTERS = (" ]
+    for reg in regs:
+        lines.append(f"    ({reg['index']}, '{reg['name']}', '{reg.get('access', 'rw')}'),")
+    lines.append(")")
+    lines += [ "", "__all__ = (" ] + [ f"    '{name}'," for name in exports ] + [ ")" ]
+    return "\n".join(lines) + "\n" + DISPATCH
+
+
+## Write or check generated file
+#  @return True when file is up to date (check) or was written
+def output(name, text, check):
+    if check:
+        try:
+            with open(name, 'r', newline='') as f:
+                current = f.read()
+        except OSError:
+            current = None
+        if current != text:
+            print(f"{name} is out of date", file=sys.stderr)
+            return False
+        return True
+    with open(name, 'w', newline='\n') as f:
+        f.write(text)
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate VSI register map C header and Python module')
+    parser.add_argument('description', help='register description (JSON)')
+    parser.add_argument('--header', help='C header file to generate')
+    parser.add_argument('--python', help='Python module file to generate')
+    parser.add_argument('--check', action='store_true', help='check that generated files are up to date')
+    args = parser.parse_args()
+
+    desc   = load(args.description)
+    source = os.path.basename(args.description)
+    ok     = True
+    if args.header:
+        guard = "__" + os.path.splitext(os.path.basename(args.header))[0].upper() + "_H"
+        ok &= output(args.header, genHeader(desc, source, guard), args.check)
+    if args.python:
+        ok &= output(args.python, genPython(desc, source), args.check)
+    sys.exit(0 if ok else 1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2026 Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+
+#include "vsi_stream.h"
+#include "arm_vsi.h"
+#include "platform_irq.h"
+#ifdef _RTE_
+#include "RTE_Components.h"
+#endif
+#include CMSIS_device_header
+
+// VSI peripheral access structures
+static ARM_VSI_Type * const VSI_Periph[VSI_STREAM_INSTANCES] = {
+  ARM_VSI0_NS, ARM_VSI1_NS, ARM_VSI2_NS, ARM_VSI3_NS,
+  ARM_VSI4_NS, ARM_VSI5_NS, ARM_VSI6_NS, ARM_VSI7_NS
+};
+
+// VSI peripheral interrupt numbers
+static const IRQn_Type VSI_IRQn[VSI_STREAM_INSTANCES] = {
+  ARM_VSI0_IRQn, ARM_VSI1_IRQn, ARM_VSI2_IRQn, ARM_VSI3_IRQn,
+  ARM_VSI4_IRQn, ARM_VSI5_IRQn, ARM_VSI6_IRQn, ARM_VSI7_IRQn
+};
+
+// Streams bound to VSI instances
+static VSI_Stream_t *Stream[VSI_STREAM_INSTANCES];
+
+// Common VSI Interrupt Handler
+static void VSI_Stream_Handler (uint32_t instance) {
+  VSI_Stream_t *stream = Stream[instance];
+  uint32_t      irq_status;
+
+  if (stream == NULL) {
+    return;
+  }
+
+  // With a single IRQ source enabled its status is known, skip the register read
+  if ((stream->irq_mask & (stream->irq_mask - 1U)) == 0U) {
+    irq_status = stream->irq_mask;
+  } else {
+    irq_status = stream->vsi->IRQ.Status;
+  }
+  stream->vsi->IRQ.Clear = irq_status;
+  __DSB();
+  __ISB();
+
+  if ((irq_status & VSI_STREAM_IRQ_BLOCK_Msk) != 0U) {
+    stream->block_in++;
+
+    // Fractional pacing: carry accumulated sub-microsecond error into the next interval
+    if (stream->period_rem != 0U) {
+      uint32_t interval = stream->interval;
+
+      stream->period_acc += stream->period_rem;
+      if (stream->period_acc >= stream->period_den) {
+        stream->period_acc -= stream->period_den;
+        interval++;
+      }
+      if (interval != stream->interval_cur) {
+        stream->interval_cur        = interval;
+        stream->vsi->Timer.Interval = interval;
+      }
+    }
+  }
+
+  if (stream->cb_event != NULL) {
+    stream->cb_event(stream, irq_status);
+  }
+}
+
+// VSI peripheral Interrupt Handlers
+void ARM_VSI0_Handler (void);
+void ARM_VSI0_Handler (void) { VSI_Stream_Handler(0U); }
+void ARM_VSI1_Handler (void);
+void ARM_VSI1_Handler (void) { VSI_Stream_Handler(1U); }
+void ARM_VSI2_Handler (void);
+void ARM_VSI2_Handler (void) { VSI_Stream_Handler(2U); }
+void ARM_VSI3_Handler (void);
+void ARM_VSI3_Handler (void) { VSI_Stream_Handler(3U); }
+void ARM_VSI4_Handler (void);
+void ARM_VSI4_Handler (void) { VSI_Stream_Handler(4U); }
+void ARM_VSI5_Handler (void);
+void ARM_VSI5_Handler (void) { VSI_Stream_Handler(5U); }
+void ARM_VSI6_Handler (void);
+void ARM_VSI6_Handler (void) { VSI_Stream_Handler(6U); }
+void ARM_VSI7_Handler (void);
+void ARM_VSI7_Handler (void) { VSI_Stream_Handler(7U); }
+
+// Bind stream to VSI instance
+int32_t VSI_Stream_Bind (VSI_Stream_t *stream, uint32_t instance, uint32_t irq_mask, VSI_Stream_Event_t cb_event, void *context) {
+  ARM_VSI_Type *vsi;
+
+  if ((stream   == NULL) ||
+      (instance >= VSI_STREAM_INSTANCES) ||
+      (irq_mask == 0U)) {
+    return VSI_STREAM_ERROR_PARAMETER;
+  }
+
+  if ((Stream[instance] != NULL) && (Stream[instance] != stream)) {
+    return VSI_STREAM_ERROR_BUSY;
+  }
+
+  vsi = VSI_Periph[instance];
+
+  stream->vsi        = vsi;
+  stream->instance   = instance;
+  stream->irq_mask   = irq_mask;
+  stream->cb_event   = cb_event;
+  stream->context    = context;
+  stream->buf        = NULL;
+  stream->block_num  = 0U;
+  stream->block_size = 0U;
+  stream->block_in   = 0U;
+  stream->block_out  = 0U;
+  stream->overrun    = 0U;
+  stream->interval     = 0U;
+  stream->interval_cur = 0U;
+  stream->period_rem   = 0U;
+  stream->period_den   = 1U;
+  stream->period_acc   = 0U;
+
+  vsi->Timer.Control = 0U;
+  vsi->DMA.Control   = 0U;
+  vsi->IRQ.Clear     = irq_mask;
+  vsi->IRQ.Enable    = irq_mask;
+
+  Stream[instance] = stream;
+
+  NVIC_EnableIRQ(VSI_IRQn[instance]);
+  __DSB();
+  __ISB();
+
+  return VSI_STREAM_OK;
+}
+
+// Release VSI instance
+int32_t VSI_Stream_Unbind (VSI_Stream_t *stream) {
+  ARM_VSI_Type *vsi;
+
+  if ((stream == NULL) ||
+      (stream->instance >= VSI_STREAM_INSTANCES) ||
+      (Stream[stream->instance] != stream)) {
+    return VSI_STREAM_ERROR_PARAMETER;
+  }
+
+  NVIC_DisableIRQ(VSI_IRQn[stream->instance]);
+  __DSB();
+  __ISB();
+
+  vsi = stream->vsi;
+  vsi->Timer.Control = 0U;
+  vsi->DMA.Control   = 0U;
+  vsi->IRQ.Clear     = stream->irq_mask;
+  vsi->IRQ.Enable    = 0U;
+
+  Stream[stream->instance] = NULL;
+
+  return VSI_STREAM_OK;
+}
+
+// Set stream block ring buffer
+int32_t VSI_Stream_SetBuf (VSI_Stream_t *stream, void *buf, uint32_t block_num, uint32_t block_size) {
+  ARM_VSI_Type *vsi = stream->vsi;
+
+  if ((buf == NULL) ||
+      (block_num == 0U) ||
+      ((block_num & (block_num - 1U)) != 0U) ||
+      (block_size == 0U)) {
+    return VSI_STREAM_ERROR_PARAMETER;
+  }
+
+  if ((vsi->DMA.Control & ARM_VSI_DMA_Enable_Msk) != 0U) {
+    return VSI_STREAM_ERROR_BUSY;
+  }
+
+  vsi->DMA.Address   = (uint32_t)buf;
+  vsi->DMA.BlockNum  = block_num;
+  vsi->DMA.BlockSize = block_size;
+
+  stream->buf        = (uint8_t *)buf;
+  stream->block_num  = block_num;
+  stream->block_size = block_size;
+  stream->block_in   = 0U;
+  stream->block_out  = 0U;
+
+  return VSI_STREAM_OK;
+}
+
+// Set stream block interval
+void VSI_Stream_SetInterval (VSI_Stream_t *stream, uint32_t interval) {
+  VSI_Stream_SetPeriod(stream, interval, 1U, 0U);
+}
+
+// Set stream block period (num/den microseconds)
+void VSI_Stream_SetPeriod (VSI_Stream_t *stream, uint64_t num, uint32_t den, uint32_t fractional) {
+  uint64_t interval;
+  uint32_t rem;
+
+  if (den == 0U) {
+    den = 1U;
+  }
+
+  interval = num / den;
+  rem      = (uint32_t)(num % den);
+
+  // Limit to the Timer range of whole microseconds
+  if (interval == 0U) {
+    interval = 1U;
+    rem      = 0U;
+  } else if (interval > 0xFFFFFFFFU) {
+    interval = 0xFFFFFFFFU;
+    rem      = 0U;
+  }
+
+  if (fractional == 0U) {
+    rem = 0U;
+  }
+
+  stream->interval     = (uint32_t)interval;
+  stream->interval_cur = (uint32_t)interval;
+  stream->period_rem   = rem;
+  stream->period_den   = den;
+  stream->period_acc   = 0U;
+
+  stream->vsi->Timer.Interval = (uint32_t)interval;
+}
+
+// Get effective stream block period
+void VSI_Stream_GetPeriod (VSI_Stream_t *stream, uint64_t *num, uint32_t *den) {
+  *num = ((uint64_t)stream->interval * stream->period_den) + stream->period_rem;
+  *den = stream->period_den;
+}
+
+// Start stream DMA and Timer, returns number of unreleased blocks dropped
+uint32_t VSI_Stream_Start (VSI_Stream_t *stream, uint32_t direction, uint32_t mode) {
+  ARM_VSI_Type *vsi = stream->vsi;
+  uint32_t      control;
+  uint32_t      skip;
+  uint32_t      dropped;
+
+  if (direction == VSI_STREAM_INPUT) {
+    vsi->DMA.Control = ARM_VSI_DMA_Direction_P2M | ARM_VSI_DMA_Enable_Msk;
+  } else {
+    vsi->DMA.Control = ARM_VSI_DMA_Direction_M2P | ARM_VSI_DMA_Enable_Msk;
+  }
+
+  // Continue the sequence at the block the DMA transfers next: block_in only advances by
+  // the ring offset, so it stays monotonic and every sequence number keeps its ring slot
+  skip    = 0U;
+  dropped = 0U;
+  if (stream->block_num != 0U) {
+    skip = (vsi->DMA.BlockIndex - stream->block_in) & (stream->block_num - 1U);
+  }
+  if (skip != 0U) {
+    // Skipped slots hold no new data, unreleased blocks before them are dropped
+    // (blocks already lapped by the DMA are not counted again)
+    dropped = stream->block_in - stream->block_out;
+    if (dropped > stream->block_num) {
+      dropped = stream->block_num;
+    }
+    stream->block_in += skip;
+    stream->block_out = stream->block_in;
+  }
+
+  control = ARM_VSI_Timer_Trig_DMA_Msk |
+            ARM_VSI_Timer_Trig_IRQ_Msk |
+            ARM_VSI_Timer_Run_Msk;
+  if (mode == VSI_STREAM_PERIODIC) {
+    control |= ARM_VSI_Timer_Periodic_Msk;
+  }
+  vsi->Timer.Control = control;
+
+  return dropped;
+}
+
+// Stop stream DMA and Timer
+void VSI_Stream_Stop (VSI_Stream_t *stream) {
+  stream->vsi->Timer.Control = 0U;
+  stream->vsi->DMA.Control   = 0U;
+}
+
+// Trigger single block transfer
+void VSI_Stream_Trigger (VSI_Stream_t *stream) {
+  stream->vsi->Timer.Control = ARM_VSI_Timer_Trig_DMA_Msk |
+                               ARM_VSI_Timer_Trig_IRQ_Msk |
+                               ARM_VSI_Timer_Run_Msk;
+}
+
+// Get oldest transferred block not yet released
+void *VSI_Stream_GetBlock (VSI_Stream_t *stream) {
+  uint32_t in, out;
+
+  if (stream->buf == NULL) {
+    return NULL;
+  }
+
+  in  = stream->block_in;
+  out = stream->block_out;
+
+  if ((in - out) > stream->block_num) {
+    // DMA has wrapped over unreleased blocks: skip to the oldest intact one
+    out               = in - stream->block_num;
+    stream->block_out = out;
+    stream->overrun   = 1U;
+  }
+
+  if (in == out) {
+    return NULL;
+  }
+
+  return (stream->buf + ((out & (stream->block_num - 1U)) * stream->block_size));
+}
+
+// Release block
+int32_t VSI_Stream_ReleaseBlock (VSI_Stream_t *stream) {
+
+  if (stream->buf == NULL) {
+    return VSI_STREAM_ERROR;
+  }
+
+  if (stream->block_in == stream->block_out) {
+    return VSI_STREAM_ERROR;
+  }
+
+  stream->block_out++;
+
+  return VSI_STREAM_OK;
+}
+
+// Get Timer overflow count
+uint32_t VSI_Stream_GetCount (VSI_Stream_t *stream) {
+  return (stream->vsi->Timer.Count);
+}